@@ -60,10 +60,12 @@ static void factorial(std::size_t n) {
 
 static std::ofstream fout;
 static std::size_t bytes = 0;
+static std::size_t allocations = 0;
 
 void* _Post_writable_byte_size_(_Size) operator new(std::size_t size) {
 
 	bytes += size;
+	allocations++;
 	void* p = std::malloc(size);
 	if (!p) throw std::bad_alloc();
 
@@ -197,7 +199,7 @@ static void DumpSubInfo(std::size_t bits) {
 	//std::cout << " Done! (" << time << (unsigned char)230 << "s)\n";
 }
 
-static void DumpMultInfo(std::size_t bits) {
+static void DumpMultInfo(std::size_t bits, bool crossover = false) {
 
 	big::Integer a(0, bits);
 	big::Integer::Rand(a);
@@ -206,9 +208,39 @@ static void DumpMultInfo(std::size_t bits) {
 	//std::cout << "(" << bits << " * " << bits << ")...";
 	Timer timer;
 	bytes = 0;
+	allocations = 0;
 	a * b;
 	double time = timer.elapsedMicroseconds();
-	fout << bits << ";" << time << ";" << bytes << "\n";
+	fout << bits << ";" << time << ";" << bytes << ";" << allocations;
+
+	// Repeat the same product with the recursive algorithms only, then forcing the Schonhage-Strassen algorithm and the number-theoretic transform, to show where the curves cross
+	if (crossover) {
+
+		const std::size_t ssaThreshold = big::Integer::GetSSAThreshold();
+		const int nttMode = big::Integer::GetNTTMode();
+
+		big::Integer::SetNTTMode(BI_NTT_OFF);
+		big::Integer::SetSSAThreshold(std::numeric_limits<std::size_t>::max());
+		timer.reset();
+		a * b;
+		double toomTime = timer.elapsedMicroseconds();
+
+		big::Integer::SetSSAThreshold(0);
+		timer.reset();
+		a * b;
+		double ssaTime = timer.elapsedMicroseconds();
+
+		big::Integer::SetNTTMode(BI_NTT_ON);
+		timer.reset();
+		a * b;
+		double nttTime = timer.elapsedMicroseconds();
+
+		big::Integer::SetSSAThreshold(ssaThreshold);
+		big::Integer::SetNTTMode(nttMode);
+		fout << ";" << toomTime << ";" << ssaTime << ";" << nttTime;
+	}
+
+	fout << "\n";
 	fout.flush();
 	//std::cout << " Done! (" << time << (unsigned char)230 << "s)\n";
 }
@@ -229,14 +261,35 @@ static void DumpDivInfo(std::size_t bits) {
 	//std::cout << " Done! (" << time << (unsigned char)230 << "s)\n";
 }
 
+static void DumpDivRatioInfo(std::size_t bits) {
+
+	// The same dividend is divided by divisors from 1/16 to 15/16 of its size, so every column is a dividend/divisor size ratio
+	big::Integer a(0, bits);
+	big::Integer::Rand(a);
+	fout << bits;
+	for (std::size_t i = 1; i < 16; i++) {
+
+		big::Integer b(0, bits * i / 16);
+		big::Integer::Rand(b);
+		Timer timer;
+		a / b;
+		double time = timer.elapsedMicroseconds();
+		fout << ";" << time;
+	}
+
+	fout << "\n";
+	fout.flush();
+}
+
 static void DumpFactInfo(std::size_t bits) {
 
 	//std::cout << "factorial(" << bits << ")...";
 	Timer timer;
 	bytes = 0;
+	allocations = 0;
 	factorial(bits);
 	double time = timer.elapsedMicroseconds();
-	fout << bits << ";" << time << ";" << bytes << "\n";
+	fout << bits << ";" << time << ";" << bytes << ";" << allocations << "\n";
 	fout.flush();
 	//std::cout << " Done! (" << time << (unsigned char)230 << "s)\n";
 }
@@ -292,6 +345,37 @@ int main() {
 
 	std::cout << " Done!\n";
 
+	std::cout << "Generating crossover data...";
+	fout.close();
+	fout.open("data-mult-crossover.csv");
+	if (!fout.is_open())
+		return -1;
+
+	for (std::size_t i = 1; i <= 32; i++)
+		DumpMultInfo(i * 1024 * 64, true);
+
+	std::cout << " Done!\n";
+
+	// The transforms are turned off, so the products run through the basecase, Karatsuba and Toom-Cook tiers only
+	std::cout << "Generating Toom-Cook data...";
+	fout.close();
+	fout.open("data-mult-toom.csv");
+	if (!fout.is_open())
+		return -1;
+
+	const std::size_t ssaThreshold = big::Integer::GetSSAThreshold();
+	const int nttMode = big::Integer::GetNTTMode();
+	big::Integer::SetNTTMode(BI_NTT_OFF);
+	big::Integer::SetSSAThreshold(std::numeric_limits<std::size_t>::max());
+
+	for (std::size_t i = 1; i <= 64; i++)
+		DumpMultInfo(i * 256 * 64);
+
+	big::Integer::SetSSAThreshold(ssaThreshold);
+	big::Integer::SetNTTMode(nttMode);
+
+	std::cout << " Done!\n";
+
 	// Division
 	std::cout << "\n--- Division ---\n";
 	TestDiv();
@@ -306,6 +390,17 @@ int main() {
 
 	std::cout << " Done!\n";
 
+	std::cout << "Generating size ratio data...";
+	fout.close();
+	fout.open("data-div-ratio.csv");
+	if (!fout.is_open())
+		return -1;
+
+	for (std::size_t i = 1; i <= 64; i++)
+		DumpDivRatioInfo(i * 64 * 64);
+
+	std::cout << " Done!\n";
+
 	// Factorial
 	std::cout << "\n--- Factorial ---\n";
 	std::cout << "Generating data...";
@@ -0,0 +1,1146 @@
+#include <cctype>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <BigInteger.hpp>
+
+// The seed of the random operands, so that every run checks the same numbers
+constexpr unsigned int SEED = 20240917;
+
+// Turns a tier off
+constexpr std::size_t NEVER = std::numeric_limits<std::size_t>::max();
+
+// The algorithms with a limb threshold (BI_KARATSUBA to BI_NEWTON)
+constexpr int ALGORITHMS = BI_NEWTON + 1;
+
+// The failed checks of the running case
+static std::size_t s_Failures = 0;
+
+/// <summary>
+/// Saves every algorithm threshold, the NTT mode and the thread count, and restores them when it goes out of scope, so that every case
+/// starts from the library defaults whatever tier it forces
+/// </summary>
+class Tiers {
+
+public:
+
+	Tiers()
+		: m_NTTMode(big::Integer::GetNTTMode()), m_ThreadCount(big::Integer::GetThreadCount())
+	{
+
+		for (int algorithm = 0; algorithm < ALGORITHMS; algorithm++)
+			m_Thresholds[algorithm] = big::Integer::GetThreshold(algorithm);
+	}
+
+	~Tiers() {
+
+		for (int algorithm = 0; algorithm < ALGORITHMS; algorithm++)
+			big::Integer::SetThreshold(algorithm, m_Thresholds[algorithm]);
+
+		big::Integer::SetNTTMode(m_NTTMode);
+		big::Integer::SetThreadCount(m_ThreadCount);
+	}
+
+	Tiers(const Tiers&) = delete;
+	Tiers& operator=(const Tiers&) = delete;
+
+	/// <summary>
+	/// Turns off every tier above the schoolbook multiplication and division
+	/// </summary>
+	static void Basecase() {
+
+		for (int algorithm = 0; algorithm < ALGORITHMS; algorithm++)
+			big::Integer::SetThreshold(algorithm, NEVER);
+
+		big::Integer::SetNTTMode(BI_NTT_OFF);
+		big::Integer::SetThreadCount(1);
+	}
+
+private:
+
+	std::size_t m_Thresholds[ALGORITHMS];
+	int m_NTTMode;
+	std::size_t m_ThreadCount;
+};
+
+// The operand patterns: random words, all ones (the longest carry chains) and a power of two (the longest borrow chains)
+constexpr int PATTERNS = 3;
+const char* const PATTERN_NAMES[PATTERNS] = { "random", "all ones", "power of two" };
+
+// The generator of the random operands
+static std::mt19937_64 s_Generator(SEED);
+
+/// <param name="words">The words, from the most significant one</param>
+/// <returns>The number made of the given words, built through their hexadecimal digits</returns>
+static big::Integer FromWords(const std::vector<std::uint64_t>& words) {
+
+	std::string hex(words.size() * 16, '0');
+	for (std::size_t i = 0; i < words.size(); i++) {
+
+		std::uint64_t word = words[i];
+		for (std::size_t j = 16; j--; word >>= 4)
+			hex[i * 16 + j] = "0123456789abcdef"[word & 15];
+	}
+
+	big::Integer n;
+	big::Integer::FromString(n, hex, 16);
+
+	return n;
+}
+
+/// <param name="limbs">The number of limbs</param>
+/// <param name="negative">True to negate the number</param>
+/// <returns>A random number of the given length</returns>
+static big::Integer Random(std::size_t limbs, bool negative = false) {
+
+	// Every word is drawn whole (big::Integer::Rand leaves the top bits of the words clear)
+	std::vector<std::uint64_t> words(limbs);
+	for (std::uint64_t& word : words)
+		word = s_Generator();
+
+	const big::Integer n = FromWords(words);
+	return negative ? big::Integer(0) - n : n;
+}
+
+/// <param name="limbs">The number of limbs</param>
+/// <param name="pattern">The operand pattern (see PATTERN_NAMES)</param>
+/// <param name="negative">True to negate the number</param>
+/// <returns>A number of the given length and pattern</returns>
+static big::Integer Operand(std::size_t limbs, int pattern, bool negative = false) {
+
+	if (pattern == 0)
+		return Random(limbs, negative);
+
+	const big::Integer n = pattern == 1 ? (big::Integer(1) << 64 * limbs) - 1 : big::Integer(1) << (64 * limbs - 1);
+	return negative ? big::Integer(0) - n : n;
+}
+
+/// <returns>The product computed by the schoolbook multiplication only</returns>
+static big::Integer BasecaseProduct(const big::Integer& a, const big::Integer& b) {
+
+	Tiers tiers;
+	Tiers::Basecase();
+
+	return a * b;
+}
+
+/// <summary>
+/// Records a failed check
+/// </summary>
+/// <param name="passed">The check result</param>
+/// <param name="what">The description of the check</param>
+static void Check(bool passed, const std::string& what) {
+
+	if (!passed) {
+
+		std::cout << "  failed: " << what << "\n";
+		s_Failures++;
+	}
+}
+
+// --- Multiplication ---
+
+static void CheckSchonhageStrassen() {
+
+	Tiers tiers;
+	big::Integer::SetNTTMode(BI_NTT_OFF);
+	big::Integer::SetSSAThreshold(64);
+
+	const std::size_t sizes[][2] = { { 64, 64 }, { 100, 97 }, { 257, 255 }, { 1000, 640 }, { 2048, 2048 } };
+	for (const auto& size : sizes) {
+
+		for (int pattern = 0; pattern < PATTERNS; pattern++) {
+
+			const big::Integer a = Operand(size[0], pattern);
+			const big::Integer b = Operand(size[1], pattern, true);
+			Check(a * b == BasecaseProduct(a, b), "SSA product of " + std::to_string(size[0]) + " x " + std::to_string(size[1]) + " limbs, " + PATTERN_NAMES[pattern]);
+		}
+	}
+}
+
+static void CheckNumberTheoreticTransform() {
+
+	Tiers tiers;
+	big::Integer::SetNTTMode(BI_NTT_ON);
+
+	const std::size_t sizes[][2] = { { 1, 1 }, { 9, 4 }, { 100, 100 }, { 777, 300 }, { 3000, 2999 } };
+	for (const auto& size : sizes) {
+
+		for (int pattern = 0; pattern < PATTERNS; pattern++) {
+
+			const big::Integer a = Operand(size[0], pattern, true);
+			const big::Integer b = Operand(size[1], pattern, true);
+			Check(a * b == BasecaseProduct(a, b), "NTT product of " + std::to_string(size[0]) + " x " + std::to_string(size[1]) + " limbs, " + PATTERN_NAMES[pattern]);
+		}
+	}
+}
+
+static void CheckSquaring() {
+
+	Tiers tiers;
+	big::Integer::SetNTTMode(BI_NTT_OFF);
+	big::Integer::SetSSAThreshold(NEVER);
+	big::Integer::SetThreshold(BI_TOOM_COOK_4, NEVER);
+	big::Integer::SetThreshold(BI_TOOM_COOK_6, NEVER);
+	big::Integer::SetThreshold(BI_TOOM_COOK_8, NEVER);
+
+	// Basecase, Karatsuba and Toom-Cook 3-Way squaring
+	const std::size_t thresholds[][2] = { { NEVER, NEVER }, { 8, NEVER }, { 8, 24 } };
+	for (const auto& threshold : thresholds) {
+
+		big::Integer::SetThreshold(BI_KARATSUBA, threshold[0]);
+		big::Integer::SetThreshold(BI_TOOM_COOK_3, threshold[1]);
+
+		for (std::size_t limbs : { 1, 7, 8, 33, 100, 301 }) {
+
+			for (int pattern = 0; pattern < PATTERNS; pattern++) {
+
+				const std::string what = std::to_string(limbs) + " limbs, " + PATTERN_NAMES[pattern];
+				const big::Integer a = Operand(limbs, pattern, limbs % 2 == 1);
+				Check(big::Integer::Square(a) == BasecaseProduct(a, a), "square of " + what);
+
+				big::Integer b = a;
+				b *= b;
+				Check(b == big::Integer::Square(a), "self product of " + what);
+			}
+		}
+	}
+}
+
+static void CheckToomCookHigherOrders() {
+
+	Tiers tiers;
+	big::Integer::SetNTTMode(BI_NTT_OFF);
+	big::Integer::SetSSAThreshold(NEVER);
+	big::Integer::SetThreshold(BI_KARATSUBA, 8);
+	big::Integer::SetThreshold(BI_TOOM_COOK_3, 24);
+
+	// Toom-Cook 4-Way, then 6-Way and 8-Way on top of it
+	const std::size_t thresholds[][3] = { { 32, NEVER, NEVER }, { 32, 48, NEVER }, { 32, 48, 64 } };
+	for (const auto& threshold : thresholds) {
+
+		big::Integer::SetThreshold(BI_TOOM_COOK_4, threshold[0]);
+		big::Integer::SetThreshold(BI_TOOM_COOK_6, threshold[1]);
+		big::Integer::SetThreshold(BI_TOOM_COOK_8, threshold[2]);
+
+		const std::size_t sizes[][2] = { { 64, 64 }, { 200, 199 }, { 333, 300 }, { 1000, 900 } };
+		for (const auto& size : sizes) {
+
+			// All ones make every evaluation and interpolation value reach its largest magnitude
+			for (int pattern = 0; pattern < PATTERNS; pattern++) {
+
+				const big::Integer a = Operand(size[0], pattern, true);
+				const big::Integer b = Operand(size[1], pattern);
+				const std::string what = std::to_string(size[0]) + " x " + std::to_string(size[1]) + " limbs, " + PATTERN_NAMES[pattern];
+				Check(a * b == BasecaseProduct(a, b), "Toom-Cook product of " + what);
+				Check(big::Integer::Square(a) == BasecaseProduct(a, a), "Toom-Cook square of " + what);
+			}
+		}
+	}
+}
+
+static void CheckUnbalanced() {
+
+	Tiers tiers;
+	big::Integer::SetNTTMode(BI_NTT_OFF);
+	big::Integer::SetSSAThreshold(NEVER);
+	big::Integer::SetThreshold(BI_KARATSUBA, 8);
+	big::Integer::SetThreshold(BI_TOOM_COOK_3, 24);
+
+	// Toom-Cook 2.5-Way (from a 3/2 ratio), 3.5-Way (from 5/2) and the blockwise slicing of the longer factor (from 7/2)
+	const std::size_t sizes[][2] = { { 150, 100 }, { 200, 101 }, { 250, 100 }, { 349, 100 }, { 351, 100 }, { 2000, 30 }, { 1234, 9 } };
+	for (const auto& size : sizes) {
+
+		for (int pattern = 0; pattern < PATTERNS; pattern++) {
+
+			const big::Integer a = Operand(size[0], pattern, true);
+			const big::Integer b = Operand(size[1], pattern, true);
+			const std::string what = std::to_string(size[0]) + " x " + std::to_string(size[1]) + " limbs, " + PATTERN_NAMES[pattern];
+			Check(a * b == BasecaseProduct(a, b), "unbalanced product of " + what);
+			Check(b * a == a * b, "swapped unbalanced product of " + what);
+		}
+	}
+}
+
+/// <returns>The product as the sum of the single-word products b * a_j shifted by j words, the rows that the schoolbook kernel accumulates</returns>
+static big::Integer RowProduct(const big::Integer& a, const big::Integer& b) {
+
+	big::Integer product = 0;
+	big::Integer rest = a < 0 ? big::Integer(0) - a : a;
+	for (std::size_t j = 0; rest != 0; j++) {
+
+		const big::Integer high = rest >> 64;
+		product += (b * (rest - (high << 64))) << 64 * j;
+		rest = high;
+	}
+
+	return a < 0 ? big::Integer(0) - product : product;
+}
+
+static void CheckInPlaceBasecase() {
+
+	Tiers tiers;
+	Tiers::Basecase();
+
+	// The product overwrites the first factor, from its most significant row down
+	const std::size_t sizes[][2] = { { 1, 1 }, { 1, 9 }, { 9, 1 }, { 2, 3 }, { 17, 17 }, { 40, 7 }, { 7, 40 } };
+	for (const auto& size : sizes) {
+
+		for (int pattern = 0; pattern < PATTERNS; pattern++) {
+
+			const big::Integer a = Operand(size[0], pattern, size[1] % 2 == 1);
+			const big::Integer b = Operand(size[1], pattern);
+			const std::string what = std::to_string(size[0]) + " x " + std::to_string(size[1]) + " limbs, " + PATTERN_NAMES[pattern];
+
+			big::Integer p = a;
+			p *= b;
+			Check(p == RowProduct(a, b) && a * b == p, "in-place schoolbook product of " + what);
+
+			big::Integer q = b;
+			q *= a;
+			Check(q == p, "swapped in-place schoolbook product of " + what);
+
+			big::Integer s = a;
+			s *= s;
+			Check(s == RowProduct(a, a), "in-place schoolbook square of " + what);
+		}
+	}
+}
+
+static void CheckADXKernel() {
+
+	Tiers tiers;
+	Tiers::Basecase();
+
+	// A prime below 2^32, so that the product of two residues fits a word
+	constexpr std::uint64_t PRIME = 4294967291u;
+
+	// Lengths around the unrolling by four of the BMI2/ADX kernel against the portable kernel (on processors without BMI2 and ADX, both
+	// products run the portable one)
+	for (std::size_t limbs : { 1, 2, 3, 4, 5, 7, 8, 9, 33, 100 }) {
+
+		for (int pattern = 0; pattern < PATTERNS; pattern++) {
+
+			const big::Integer a = Operand(limbs, pattern, limbs % 2 == 1);
+			const big::Integer b = Operand(limbs + 3, pattern);
+			const std::string what = std::to_string(limbs) + " x " + std::to_string(limbs + 3) + " limbs, " + PATTERN_NAMES[pattern];
+
+			big::Integer::SetADXKernel(false);
+			Check(!big::Integer::GetADXKernel(), "the BMI2/ADX kernel can be turned off");
+
+			const big::Integer product = a * b;
+			const big::Integer square = big::Integer::Square(b);
+			Check(big::ModWord(product, PRIME) == big::ModWord(a, PRIME) * big::ModWord(b, PRIME) % PRIME, "portable kernel product of " + what);
+
+			big::Integer::SetADXKernel(true);
+			Check(a * b == product && big::Integer::Square(b) == square, "BMI2/ADX kernel product and square of " + what);
+		}
+	}
+}
+
+// --- Division ---
+
+/// <returns>The absolute value of the number</returns>
+static big::Integer Abs(const big::Integer& n) {
+
+	return n < 0 ? big::Integer(0) - n : n;
+}
+
+/// <returns>True if the number is a zero without a minus sign</returns>
+static bool IsPlusZero(const big::Integer& n) {
+
+	return n == 0 && !(n < 0) && n.ToString() == "0";
+}
+
+/// <summary>
+/// Checks a truncated division against the schoolbook one and the identity q * d + r = n, with |r| < |d| and r of the sign of n
+/// </summary>
+/// <param name="n">The dividend</param>
+/// <param name="d">The divisor</param>
+/// <param name="what">The description of the division</param>
+static void CheckDivision(const big::Integer& n, const big::Integer& d, const std::string& what) {
+
+	const big::Integer q = n / d;
+	const big::Integer r = n % d;
+	Check(q * d + r == n && Abs(r) < Abs(d) && (r == 0 || (r < 0) == (n < 0)), "q * d + r == n for " + what);
+
+	Tiers tiers;
+	Tiers::Basecase();
+	Check(q == n / d && r == n % d, "schoolbook quotient and remainder for " + what);
+}
+
+static void CheckSchoolbookDivision() {
+
+	Tiers tiers;
+	Tiers::Basecase();
+
+	// Divisors whose top word is all ones (already normalized) or a power of two, and dividend words equal to it or just below it, at the
+	// edges of the quotient word estimate: the all-ones estimate, its corrections against the second divisor word and the add back
+	constexpr std::uint64_t MAX = std::numeric_limits<std::uint64_t>::max();
+	constexpr std::uint64_t HIGH = 1ULL << 63;
+	const std::uint64_t words[] = { 0, 1, HIGH - 1, HIGH, MAX - 1, MAX };
+	constexpr std::size_t WORDS = sizeof(words) / sizeof(words[0]);
+
+	std::vector<big::Integer> divisors;
+	for (std::uint64_t top : { MAX, MAX - 1, HIGH, HIGH + 1 }) {
+
+		divisors.push_back(FromWords({ top }));
+		for (std::uint64_t low : words) {
+
+			divisors.push_back(FromWords({ top, low }));
+			divisors.push_back(FromWords({ top, low, MAX - low }));
+		}
+	}
+
+	// Every four-word dividend made of those words
+	for (std::size_t i = 0; i < WORDS * WORDS * WORDS * WORDS; i++) {
+
+		const big::Integer n = FromWords({ words[i % WORDS], words[i / WORDS % WORDS], words[i / (WORDS * WORDS) % WORDS], words[i / (WORDS * WORDS * WORDS)] });
+		for (std::size_t j = 0; j < divisors.size(); j++)
+			CheckDivision(i % 2 == 0 ? n : big::Integer(0) - n, divisors[j], "dividend " + std::to_string(i) + " by divisor " + std::to_string(j) + " of the special words");
+	}
+}
+
+static void CheckBurnikelZiegler() {
+
+	Tiers tiers;
+	big::Integer::SetThreshold(BI_NEWTON, NEVER);
+
+	for (std::size_t threshold : { 2, 5, 16 }) {
+
+		big::Integer::SetThreshold(BI_BURNIKEL_ZIEGLER, threshold);
+
+		const std::size_t sizes[][2] = { { 40, 20 }, { 100, 33 }, { 301, 150 }, { 600, 97 }, { 1000, 500 } };
+		for (const auto& size : sizes) {
+
+			for (int pattern = 0; pattern < PATTERNS; pattern++) {
+
+				const big::Integer n = Operand(size[0], pattern, size[1] % 2 == 1);
+				const big::Integer d = Operand(size[1], pattern);
+				CheckDivision(n, d, std::to_string(size[0]) + " / " + std::to_string(size[1]) + " limbs, " + PATTERN_NAMES[pattern] + " (threshold " + std::to_string(threshold) + ")");
+			}
+		}
+
+		// An all-ones dividend and a divisor whose top word is 1 stress the quotient digit corrections
+		const big::Integer ones = (big::Integer(1) << 64 * 300) - 1;
+		const big::Integer d = (big::Integer(1) << 64 * 120) + 1;
+		CheckDivision(ones, d, "all ones by 2^7680 + 1 (threshold " + std::to_string(threshold) + ")");
+	}
+}
+
+static void CheckNewton() {
+
+	Tiers tiers;
+	big::Integer::SetThreshold(BI_BURNIKEL_ZIEGLER, NEVER);
+	big::Integer::SetThreshold(BI_NEWTON, 2);
+
+	const std::size_t sizes[][2] = { { 10, 4 }, { 100, 40 }, { 500, 240 }, { 900, 100 } };
+	for (const auto& size : sizes) {
+
+		// The first division by a divisor caches it, the next ones multiply by its reciprocal
+		const big::Integer d = Random(size[1], true);
+		for (int i = 0; i < 3; i++) {
+
+			const big::Integer n = Random(size[0], i == 1);
+			CheckDivision(n, d, std::to_string(size[0]) + " / " + std::to_string(size[1]) + " limbs (division " + std::to_string(i + 1) + ")");
+		}
+
+		for (int pattern = 1; pattern < PATTERNS; pattern++) {
+
+			const big::Integer n = Operand(size[0], pattern, true);
+			const big::Integer e = Operand(size[1], pattern);
+			for (int i = 0; i < 2; i++)
+				CheckDivision(n, e, std::to_string(size[0]) + " / " + std::to_string(size[1]) + " limbs, " + PATTERN_NAMES[pattern] + " (division " + std::to_string(i + 1) + ")");
+		}
+
+		const std::size_t bits = size[0] * 64;
+		const big::Integer reciprocal = big::Integer::Reciprocal(Abs(d), bits);
+
+		Tiers basecase;
+		Tiers::Basecase();
+		Check(reciprocal == (big::Integer(1) << bits) / Abs(d), "reciprocal of " + std::to_string(size[1]) + " limbs");
+	}
+
+	// Divisors whose top bits are all ones, or a power of two, at the precision of their own length and just above it
+	for (std::size_t limbs : { 1, 2, 40 }) {
+
+		const std::size_t bits = limbs * 64;
+		const big::Integer divisors[] = { (big::Integer(1) << bits) - 1, big::Integer(1) << (bits - 1), (big::Integer(1) << bits) - (big::Integer(1) << (bits / 2)) };
+		const char* names[] = { "2^b - 1", "2^(b - 1)", "2^b - 2^(b / 2)" };
+		for (int i = 0; i < 3; i++) {
+
+			for (std::size_t precision : { bits, bits + 1, bits + 64 }) {
+
+				const big::Integer reciprocal = big::Integer::Reciprocal(divisors[i], precision);
+
+				Tiers basecase;
+				Tiers::Basecase();
+				Check(reciprocal == (big::Integer(1) << precision) / divisors[i], std::string("reciprocal of ") + names[i] + " for b = " + std::to_string(bits) + " at " + std::to_string(precision) + " bits of precision");
+			}
+		}
+	}
+}
+
+static void CheckDivisor() {
+
+	Tiers tiers;
+
+	// The word reciprocal, then the Barrett reciprocal of the whole divisor once it is longer than the Newton threshold
+	for (std::size_t threshold : { NEVER, (std::size_t)2 }) {
+
+		big::Integer::SetThreshold(BI_NEWTON, threshold);
+
+		const std::size_t sizes[][2] = { { 5, 1 }, { 40, 3 }, { 300, 100 }, { 700, 350 } };
+		for (const auto& size : sizes) {
+
+			for (int pattern = 0; pattern < PATTERNS; pattern++) {
+
+				const big::Divisor divisor(Operand(size[1], pattern, size[0] % 2 == 0));
+				const big::Integer d = divisor.Value();
+				for (int i = 0; i < 3; i++) {
+
+					const big::Integer n = Operand(size[0] - i, pattern, i == 2);
+					const std::string what = std::to_string(size[0] - i) + " / " + std::to_string(size[1]) + " limbs, " + PATTERN_NAMES[pattern];
+
+					big::Integer q, r;
+					divisor.DivMod(n, q, r);
+					Check(divisor.Div(n) == q && divisor.Mod(n) == r, "Div and Mod agree with DivMod for " + what);
+					Check(q * d + r == n && Abs(r) < Abs(d) && (r == 0 || (r < 0) == (n < 0)), "prepared q * d + r == n for " + what);
+
+					Tiers basecase;
+					Tiers::Basecase();
+					Check(q == n / d && r == n % d, "prepared quotient and remainder against the schoolbook ones for " + what);
+				}
+
+				// A dividend below the divisor, and a multiple of it, of the opposite sign
+				const big::Integer multiple = d * (d < 0 ? 3 : -3);
+				Check(IsPlusZero(divisor.Div(d < 0 ? 1 : -1)) && IsPlusZero(divisor.Mod(multiple)), "prepared zero quotient and remainder for " + std::to_string(size[1]) + " limbs, " + PATTERN_NAMES[pattern]);
+			}
+		}
+	}
+}
+
+// --- Modular arithmetic ---
+
+/// <returns>base^exp mod m computed by square-and-multiply with the schoolbook multiplication and division</returns>
+static big::Integer BasecasePowMod(const big::Integer& base, const big::Integer& exp, const big::Integer& m) {
+
+	Tiers tiers;
+	Tiers::Basecase();
+
+	const big::Integer b = big::Mod(base, m, BI_ROUND_FLOOR);
+	big::Integer r = big::Mod(1, m);
+	for (std::size_t i = exp.DigitCount(2); i--;) {
+
+		r = r * r % m;
+		if ((exp >> i) % 2 != 0)
+			r = r * b % m;
+	}
+
+	return r;
+}
+
+static void CheckMontgomery() {
+
+	Tiers tiers;
+	big::Integer::SetNTTMode(BI_NTT_OFF);
+	big::Integer::SetSSAThreshold(NEVER);
+
+	// Schoolbook and Karatsuba products inside the reduction
+	for (std::size_t threshold : { NEVER, (std::size_t)8 }) {
+
+		big::Integer::SetThreshold(BI_KARATSUBA, threshold);
+
+		for (std::size_t limbs : { 1, 4, 17, 40 }) {
+
+			for (int pattern = 0; pattern < PATTERNS; pattern++) {
+
+				// The all-ones modulus is odd already, the power of two is made odd by adding one
+				const big::Integer m = pattern == 0 ? Random(limbs) * 2 + 1 : Operand(limbs, pattern) + (pattern - 1);
+				const big::Integer a = Operand(limbs + 1, pattern, true);
+				const big::Integer b = Operand(limbs, pattern);
+				const std::string what = std::to_string(limbs) + " limb " + PATTERN_NAMES[pattern] + " modulus";
+
+				const big::MontgomeryContext context(m);
+				const big::Integer am = context.ToMontgomery(a);
+				const big::Integer bm = context.ToMontgomery(b);
+				const big::Integer am1 = big::Mod(a, m, BI_ROUND_FLOOR);
+
+				Check(context.FromMontgomery(am) == am1, "Montgomery form round trip with a " + what);
+				Check(context.FromMontgomery(context.Mult(am, bm)) == am1 * b % m, "Montgomery product with a " + what);
+				Check(context.FromMontgomery(context.Square(am)) == am1 * am1 % m, "Montgomery square with a " + what);
+
+				// Odd moduli go through the Montgomery form, even ones through a prepared divisor
+				const big::Integer exp = Random(3);
+				Check(context.Pow(a, exp) == BasecasePowMod(a, exp, m), "Montgomery power with a " + what);
+				Check(big::PowMod(a, exp, m) == BasecasePowMod(a, exp, m), "PowMod with an odd " + what);
+				Check(big::PowMod(a, exp, m + 1) == BasecasePowMod(a, exp, m + 1), "PowMod with an even " + what);
+			}
+		}
+	}
+}
+
+static void CheckFixedBasePow() {
+
+	Tiers tiers;
+	big::Integer::SetThreshold(BI_KARATSUBA, 8);
+
+	for (std::size_t limbs : { 1, 6, 24 }) {
+
+		const big::Integer m = Random(limbs) * 2 + 1;
+		const big::Integer g = Random(limbs, true);
+
+		// Explicit comb sizes, and the ones chosen from the exponent bits
+		for (std::size_t teeth : { 0, 1, 3, 8 }) {
+
+			const big::FixedBasePow pow(g, m, 128, teeth);
+			const std::string what = std::to_string(limbs) + " limb modulus and " + std::to_string(pow.Teeth()) + " teeth";
+
+			for (std::size_t bits : { 0, 1, 64, 128, 200 }) {
+
+				// 200 bits exceed the table, which then falls back to PowMod
+				const big::Integer exp = bits == 0 ? big::Integer(0) : (Random((bits + 63) / 64) >> ((64 - bits % 64) % 64)) | (big::Integer(1) << (bits - 1));
+				Check(pow.Pow(exp) == BasecasePowMod(g, exp, m), "fixed-base power of a " + std::to_string(bits) + " bit exponent with a " + what);
+			}
+		}
+	}
+}
+
+// --- Threads ---
+
+static void CheckParallel() {
+
+	Tiers tiers;
+	big::Integer::SetNTTMode(BI_NTT_OFF);
+	big::Integer::SetSSAThreshold(NEVER);
+	big::Integer::SetThreshold(BI_KARATSUBA, 8);
+	big::Integer::SetThreshold(BI_TOOM_COOK_3, 24);
+	big::Integer::SetThreshold(BI_TOOM_COOK_4, 64);
+	big::Integer::SetThreshold(BI_TOOM_COOK_6, NEVER);
+	big::Integer::SetThreshold(BI_TOOM_COOK_8, NEVER);
+	big::Integer::SetParallelThreshold(8);
+
+	// The top recursion levels of the products and squares, and the products under the division, are split among the threads
+	for (std::size_t threads : { 2, 4 }) {
+
+		big::Integer::SetThreadCount(threads);
+
+		const std::size_t sizes[][2] = { { 8, 8 }, { 64, 64 }, { 200, 150 }, { 700, 699 }, { 1500, 300 } };
+		for (const auto& size : sizes) {
+
+			for (int pattern = 0; pattern < PATTERNS; pattern++) {
+
+				const big::Integer a = Operand(size[0], pattern, true);
+				const big::Integer b = Operand(size[1], pattern);
+				const std::string what = std::to_string(size[0]) + " x " + std::to_string(size[1]) + " limbs, " + PATTERN_NAMES[pattern] + ", " + std::to_string(threads) + " threads";
+
+				// Repeated, so that a race between the tasks is unlikely to go unnoticed
+				const big::Integer product = BasecaseProduct(a, b);
+				for (int i = 0; i < 3; i++)
+					Check(a * b == product, "parallel product of " + what);
+
+				Check(big::Integer::Square(a) == BasecaseProduct(a, a), "parallel square of " + what);
+				Check((product + b - 1) / b == a + 1 && product % b == 0, "division over parallel products of " + what);
+			}
+		}
+
+		const big::Integer m = Random(40) * 2 + 1;
+		const big::Integer base = Random(40);
+		const big::Integer exp = Random(2);
+		Check(big::PowMod(base, exp, m) == BasecasePowMod(base, exp, m), "PowMod over parallel products with " + std::to_string(threads) + " threads");
+	}
+}
+
+// --- Exact and rounded division ---
+
+static void CheckDivExact() {
+
+	Tiers tiers;
+
+	// The 2-adic quotient, then the ordinary division it hands over to when both the quotient and the divisor are long
+	for (std::size_t threshold : { NEVER, (std::size_t)2 }) {
+
+		big::Integer::SetThreshold(BI_BURNIKEL_ZIEGLER, threshold);
+
+		const std::size_t sizes[][2] = { { 1, 1 }, { 30, 1 }, { 1, 30 }, { 50, 20 }, { 20, 50 }, { 200, 200 } };
+		for (const auto& size : sizes) {
+
+			for (int pattern = 0; pattern < PATTERNS; pattern++) {
+
+				const big::Integer a = Operand(size[0], pattern, size[1] % 2 == 0);
+				big::Integer b = Operand(size[1], pattern, size[0] % 2 == 0);
+				if (b == 0)
+					b = 1;
+
+				const std::string what = std::to_string(size[0]) + " x " + std::to_string(size[1]) + " limbs, " + PATTERN_NAMES[pattern];
+				Check(big::DivExact(a * b, b) == a, "DivExact(a * b, b) == a for " + what);
+
+				// Even divisors shift out their trailing zeros first
+				const big::Integer shifted = b << 70;
+				Check(big::DivExact(a * shifted, shifted) == a, "DivExact(a * b, b) == a for an even divisor and " + what);
+			}
+		}
+	}
+}
+
+static void CheckRoundedDivision() {
+
+	Tiers tiers;
+
+	for (std::size_t threshold : { NEVER, (std::size_t)2 }) {
+
+		big::Integer::SetThreshold(BI_BURNIKEL_ZIEGLER, threshold);
+
+		const std::size_t sizes[][2] = { { 1, 1 }, { 3, 1 }, { 40, 15 }, { 120, 60 } };
+		for (const auto& size : sizes) {
+
+			for (int pattern = 0; pattern < PATTERNS; pattern++) {
+
+				for (int signs = 0; signs < 4; signs++) {
+
+					const big::Integer a = Operand(size[0], pattern, (signs & 1) != 0);
+					big::Integer b = Operand(size[1], pattern, (signs & 2) != 0);
+					if (b == 0)
+						b = 1;
+
+					for (int rounding : { BI_ROUND_TRUNC, BI_ROUND_FLOOR, BI_ROUND_CEIL }) {
+
+						const std::string what = std::to_string(size[0]) + " / " + std::to_string(size[1]) + " limbs, " + PATTERN_NAMES[pattern] + ", signs " + std::to_string(signs) + ", rounding " + std::to_string(rounding);
+
+						big::Integer q, r;
+						big::DivMod(a, b, q, r, rounding);
+						Check(q * b + r == a && Abs(r) < Abs(b), "q * b + r == a for " + what);
+						Check(big::Div(a, b, rounding) == q && big::Mod(a, b, rounding) == r, "Div and Mod agree with DivMod for " + what);
+
+						// The truncated remainder has the sign of the dividend, the floored one the sign of the divisor, the ceiled one the opposite one
+						const bool negative = rounding == BI_ROUND_TRUNC ? a < 0 : (rounding == BI_ROUND_FLOOR ? b < 0 : !(b < 0));
+						Check(r == 0 || (r < 0) == negative, "remainder sign for " + what);
+
+						// The native remainder, with a divisor of the sign of b
+						const long long d = (big::ModWord(b, 1000003LL, BI_ROUND_FLOOR) + 1) * (b < 0 ? -1 : 1);
+						Check(big::ModWord(a, d, rounding) == big::Mod(a, d, rounding), "native remainder for " + what);
+
+						// Unsigned divisors, one of them above the signed range, give the floor residue whatever the rounding
+						const std::uint64_t ud = 10000000000000000000ULL;
+						Check(big::ModWord(a, 1000000007u, rounding) == big::Mod(a, 1000000007, BI_ROUND_FLOOR), "unsigned native remainder for " + what);
+						Check(big::Integer(std::to_string(big::ModWord(a, ud, rounding))) == big::Mod(a, "10000000000000000000", BI_ROUND_FLOOR), "unsigned native remainder above 2^63 for " + what);
+					}
+				}
+			}
+		}
+	}
+}
+
+// --- Conversions ---
+
+// A power of ten that fits a signed native word, so that the reference conversion only needs native remainders
+constexpr long long DECIMAL_CHUNK = 1000000000000000000LL;
+constexpr std::size_t DECIMAL_CHUNK_DIGITS = 18;
+
+/// <returns>The decimal string of the number, computed by the schoolbook division by a native power of ten</returns>
+static std::string BasecaseDecimal(big::Integer n) {
+
+	Tiers tiers;
+	Tiers::Basecase();
+
+	const bool negative = n < 0;
+	n = Abs(n);
+
+	std::string digits;
+	do {
+
+		std::string chunk = std::to_string(big::ModWord(n, DECIMAL_CHUNK));
+		n = n / DECIMAL_CHUNK;
+		if (n != 0)
+			chunk.insert(0, DECIMAL_CHUNK_DIGITS - chunk.size(), '0');
+
+		digits.insert(0, chunk);
+	} while (n != 0);
+
+	return negative ? "-" + digits : digits;
+}
+
+/// <summary>
+/// Forces one of the multiplication and division tiers used by the divide-and-conquer conversions
+/// </summary>
+/// <param name="tier">0 for the schoolbook algorithms, 1 for Karatsuba, Toom-Cook and Burnikel-Ziegler, 2 for the NTT and Newton's method</param>
+static void ConversionTier(int tier) {
+
+	Tiers::Basecase();
+	if (tier == 1) {
+
+		big::Integer::SetThreshold(BI_KARATSUBA, 8);
+		big::Integer::SetThreshold(BI_TOOM_COOK_3, 24);
+		big::Integer::SetThreshold(BI_BURNIKEL_ZIEGLER, 2);
+	}
+
+	else if (tier == 2) {
+
+		big::Integer::SetNTTMode(BI_NTT_ON);
+		big::Integer::SetThreshold(BI_NEWTON, 2);
+	}
+}
+
+// The conversion tiers of ConversionTier
+constexpr int CONVERSION_TIERS = 3;
+
+// The limb sizes around the divide-and-conquer threshold of the decimal conversions (60 limbs)
+const std::size_t CONVERSION_SIZES[] = { 1, 2, 59, 60, 61, 200, 700 };
+
+static void CheckToString() {
+
+	Tiers tiers;
+
+	for (int tier = 0; tier < CONVERSION_TIERS; tier++) {
+
+		for (std::size_t limbs : CONVERSION_SIZES) {
+
+			const big::Integer n = Random(limbs, limbs % 2 != 0);
+			const std::string expected = BasecaseDecimal(n);
+
+			ConversionTier(tier);
+			Check(n.ToString() == expected, "ToString of " + std::to_string(limbs) + " limbs, tier " + std::to_string(tier));
+		}
+
+		// Powers of ten leave runs of zeros in every half of the split
+		big::Integer power = 1;
+		for (std::size_t chunks = 1; chunks <= 80; chunks++) {
+
+			power *= DECIMAL_CHUNK;
+			if (chunks % 20 != 0)
+				continue;
+
+			ConversionTier(tier);
+			Check(power.ToString() == "1" + std::string(chunks * DECIMAL_CHUNK_DIGITS, '0'), "ToString of 10^" + std::to_string(chunks * DECIMAL_CHUNK_DIGITS) + ", tier " + std::to_string(tier));
+			Check((power - 1).ToString() == std::string(chunks * DECIMAL_CHUNK_DIGITS, '9'), "ToString of 10^" + std::to_string(chunks * DECIMAL_CHUNK_DIGITS) + " - 1, tier " + std::to_string(tier));
+		}
+	}
+}
+
+/// <returns>The number of the decimal string, computed with Horner's rule over native chunks of digits</returns>
+static big::Integer BasecaseParse(const std::string& str) {
+
+	Tiers tiers;
+	Tiers::Basecase();
+
+	const bool negative = !str.empty() && str[0] == '-';
+	const std::size_t start = negative ? 1 : 0;
+
+	// The first chunk takes the digits left over by the full ones
+	big::Integer n = 0;
+	std::size_t end = start + (str.size() - start) % DECIMAL_CHUNK_DIGITS;
+	if (end > start)
+		n = std::stoll(str.substr(start, end - start));
+
+	for (; end < str.size(); end += DECIMAL_CHUNK_DIGITS)
+		n = n * DECIMAL_CHUNK + std::stoll(str.substr(end, DECIMAL_CHUNK_DIGITS));
+
+	return negative ? big::Integer(0) - n : n;
+}
+
+/// <returns>A random string of decimal digits</returns>
+static std::string RandomDigits(std::mt19937& generator, std::size_t digits) {
+
+	std::string str(digits, '0');
+	for (char& c : str)
+		c = (char)('0' + generator() % 10);
+
+	return str;
+}
+
+// The digit lengths around the chunk size and the divide-and-conquer threshold of the decimal conversions (60 limbs, about 1156 digits)
+const std::size_t PARSE_LENGTHS[] = { 1, 18, 19, 20, 38, 1100, 1155, 1157, 1200, 4000, 13000 };
+
+static void CheckFromString() {
+
+	Tiers tiers;
+	std::mt19937 generator(SEED);
+
+	for (int tier = 0; tier < CONVERSION_TIERS; tier++) {
+
+		for (std::size_t digits : PARSE_LENGTHS) {
+
+			const std::string what = std::to_string(digits) + " digits, tier " + std::to_string(tier);
+
+			// Random digits, a negative number, and runs of zeros and nines in the middle of the split
+			std::string strings[] = { RandomDigits(generator, digits), "-" + RandomDigits(generator, digits), RandomDigits(generator, digits) };
+			strings[2].replace(0, digits / 2, digits / 2, '9');
+			strings[2].replace(digits / 2, digits / 4, digits / 4, '0');
+
+			for (const std::string& str : strings) {
+
+				const big::Integer expected = BasecaseParse(str);
+
+				ConversionTier(tier);
+				big::Integer n;
+				Check(big::Integer::FromString(n, str) && n == expected, "FromString of " + what);
+				Check(big::Integer(str) == expected, "string constructor of " + what);
+			}
+
+			// The validation is the same on every path: a leading minus sign and digits only
+			big::Integer n;
+			std::string invalid = strings[0];
+			invalid[digits / 2] = 'x';
+			Check(!big::Integer::FromString(n, invalid), "FromString rejects a letter in " + what);
+			Check(!big::Integer::FromString(n, strings[0] + "-"), "FromString rejects a trailing minus sign in " + what);
+		}
+
+		ConversionTier(tier);
+		big::Integer n;
+		Check(!big::Integer::FromString(n, "") && !big::Integer::FromString(n, "-"), "FromString rejects an empty number, tier " + std::to_string(tier));
+		Check(big::Integer::FromString(n, std::string(3000, '0') + "42") && n == 42, "FromString of leading zeros, tier " + std::to_string(tier));
+	}
+}
+
+/// <returns>The string of the number in the given base, computed digit by digit with the schoolbook division</returns>
+static std::string BasecaseDigits(big::Integer n, int base) {
+
+	Tiers tiers;
+	Tiers::Basecase();
+
+	const bool negative = n < 0;
+	n = Abs(n);
+
+	std::string digits;
+	do {
+
+		digits.insert(digits.begin(), "0123456789abcdefghijklmnopqrstuvwxyz"[big::ModWord(n, base)]);
+		n = n / base;
+	} while (n != 0);
+
+	return negative ? "-" + digits : digits;
+}
+
+/// <returns>The string in uppercase</returns>
+static std::string Uppercase(std::string str) {
+
+	for (char& c : str)
+		c = (char)std::toupper((unsigned char)c);
+
+	return str;
+}
+
+static void CheckBases() {
+
+	for (int base = 2; base <= 36; base++) {
+
+		for (std::size_t limbs : { 1, 2, 61, 200 }) {
+
+			const std::string what = std::to_string(limbs) + " limbs in base " + std::to_string(base);
+			const big::Integer n = Random(limbs, limbs % 2 == 0);
+			const std::string expected = BasecaseDigits(n, base);
+
+			Check(n.ToString(base) == expected, "ToString of " + what);
+			Check(n.DigitCount(base) == expected.size() - (n < 0 ? 1 : 0), "DigitCount of " + what);
+
+			big::Integer m;
+			Check(big::Integer::FromString(m, expected, base) && m == n, "FromString of " + what);
+			Check(big::Integer::FromString(m, Uppercase(expected), base) && m == n, "FromString of uppercase " + what);
+		}
+
+		big::Integer n;
+		Check(!big::Integer::FromString(n, std::string(1, "0123456789abcdefghijklmnopqrstuvwxyz"[base - 1] + 1), base), "FromString rejects the digit past base " + std::to_string(base));
+	}
+
+	for (int base : { 1, 37 }) {
+
+		bool thrown = false;
+		try {
+
+			big::Integer(42).ToString(base);
+		}
+
+		catch (const std::invalid_argument&) {
+
+			thrown = true;
+		}
+
+		Check(thrown, "ToString throws for base " + std::to_string(base));
+	}
+
+	// The stream flags pick the base, the prefix and the case, and the prefix goes after the sign
+	const big::Integer n = Random(5, true);
+	const std::string hex = BasecaseDigits(n, 16).substr(1);
+	const std::string oct = BasecaseDigits(n, 8).substr(1);
+
+	std::ostringstream os;
+	os << std::hex << n << " " << std::showbase << n << " " << std::uppercase << n << " " << std::oct << n << " " << std::noshowbase << n << " " << std::showbase << big::Integer(0);
+	Check(os.str() == "-" + hex + " -0x" + hex + " -0X" + Uppercase(hex) + " -0" + oct + " -" + oct + " 0", "hexadecimal and octal output");
+
+	big::Integer a, b, c, d;
+	std::istringstream is("-" + Uppercase(hex) + " -0x" + hex + " -0" + oct + " " + oct);
+	is >> std::hex >> a;
+	is.unsetf(std::ios_base::basefield);
+	is >> b >> c >> std::oct >> d;
+	Check(!is.fail() && a == n && b == n && c == n && d == Abs(n), "hexadecimal and octal input");
+}
+
+// The vector kernels of the decimal conversions are picked by the processor at runtime and have no setter, so these checks run the
+// SSE4.1 and AVX2 ones where they are available and the scalar ones elsewhere. They aim at the lanes of the kernels: digits around
+// the sixteen converted at once, the 32 characters scanned at once, and the extreme values of a chunk
+static void CheckDigitKernels() {
+
+	std::mt19937 generator(SEED);
+
+	// Every length of the most significant chunk, around the sixteen digits read at once and the 32 characters scanned at once
+	for (std::size_t digits = 1; digits <= 80; digits++) {
+
+		const std::string what = std::to_string(digits) + " digits";
+		const std::string strings[] = { "1" + std::string(digits - 1, '0'), std::string(digits, '9'), "9" + RandomDigits(generator, digits - 1) };
+		for (const std::string& str : strings) {
+
+			const big::Integer expected = BasecaseParse(str);
+
+			big::Integer n;
+			Check(big::Integer::FromString(n, str) && n == expected, "FromString of " + what);
+			Check(expected.ToString() == str, "ToString of " + what);
+		}
+	}
+
+	// A character just outside the digits, or one that is negative as a signed char, at every position of a scanned block
+	const std::string digits = RandomDigits(generator, 100);
+	for (const char invalid : { '/', ':', ' ', 'a', '\x80', '\xb9' }) {
+
+		for (std::size_t position = 0; position < digits.size(); position++) {
+
+			std::string str = digits;
+			str[position] = invalid;
+
+			const std::string what = "character " + std::to_string((unsigned char)invalid) + " at " + std::to_string(position);
+
+			big::Integer n;
+			Check(!big::Integer::FromString(n, str), "FromString rejects the " + what);
+
+			const big::from_chars_result result = big::from_chars(str.data(), str.data() + str.size(), n);
+			Check(position == 0 ? result.ec == std::errc::invalid_argument : result.ptr == str.data() + position && n == BasecaseParse(digits.substr(0, position)), "from_chars stops at the " + what);
+		}
+	}
+}
+
+static void CheckCharConversions() {
+
+	for (int base : { 2, 8, 10, 16, 36 }) {
+
+		for (std::size_t limbs : { 0, 1, 61, 200 }) {
+
+			const std::string what = std::to_string(limbs) + " limbs in base " + std::to_string(base);
+			const big::Integer n = limbs == 0 ? big::Integer(0) : Random(limbs, limbs % 2 != 0);
+			const std::string expected = n.ToString(base);
+			const std::size_t length = n.DigitCount(base) + (n < 0 ? 1 : 0);
+			Check(length == expected.size(), "DigitCount of " + what);
+
+			// A buffer of DigitCount characters is enough, and one less is not
+			std::string buffer(length, '\0');
+			big::to_chars_result written = big::to_chars(&buffer[0], &buffer[0] + length, n, base);
+			Check(written.ec == std::errc() && written.ptr == &buffer[0] + length && buffer == expected, "to_chars of " + what);
+
+			written = big::to_chars(&buffer[0], &buffer[0] + length - 1, n, base);
+			Check(written.ec == std::errc::value_too_large && written.ptr == &buffer[0] + length - 1, "to_chars into a short buffer of " + what);
+
+			// The number ends at the first character that is not a digit
+			const std::string str = expected + "-z!";
+			big::Integer m;
+			const big::from_chars_result read = big::from_chars(str.data(), str.data() + str.size(), m, base);
+			Check(read.ec == std::errc() && read.ptr == str.data() + expected.size() && m == n, "from_chars of " + what);
+		}
+	}
+
+	// A range that does not start with a number leaves the big integer unchanged
+	big::Integer n = 42;
+	for (const char* chars : { "", "-", "-x", " 1" }) {
+
+		const std::string str = chars;
+		const big::from_chars_result read = big::from_chars(str.data(), str.data() + str.size(), n);
+		Check(read.ec == std::errc::invalid_argument && read.ptr == str.data() && n == 42, "from_chars rejects \"" + str + "\"");
+	}
+
+	// The digit counts step exactly at the powers of the base
+	big::Integer power = 1;
+	for (std::size_t digits = 1; digits <= 200; digits++) {
+
+		power *= 10;
+		Check(power.DigitCount() == digits + 1 && (power - 1).DigitCount() == digits, "DigitCount around 10^" + std::to_string(digits));
+		Check((big::Integer(1) << digits).DigitCount(2) == digits + 1 && ((big::Integer(1) << digits) - 1).DigitCount(2) == digits, "DigitCount around 2^" + std::to_string(digits));
+	}
+}
+
+static void CheckZeroSigns() {
+
+	// The single-word, the in-place and the general multiplications
+	for (std::size_t limbs : { 1, 2, 40 }) {
+
+		const big::Integer n = Random(limbs, true);
+		const std::string what = std::to_string(limbs) + " limbs";
+		Check(IsPlusZero(n * big::Integer(0)) && IsPlusZero(big::Integer(0) * n), "product of zero and a negative number of " + what);
+
+		big::Integer m = n;
+		m *= 0;
+		Check(IsPlusZero(m), "in-place product of a negative number of " + what + " and zero");
+	}
+
+	Check(IsPlusZero(big::Integer(0) * big::Integer(-5)), "product of zero and -5");
+
+	// A quotient that truncates to zero
+	for (int rounding : { BI_ROUND_TRUNC, BI_ROUND_FLOOR, BI_ROUND_CEIL }) {
+
+		big::Integer q, r;
+		big::DivMod(big::Integer(-3), big::Integer(5), q, r, rounding);
+		Check(rounding == BI_ROUND_FLOOR || IsPlusZero(q), "quotient of -3 / 5, rounding " + std::to_string(rounding));
+		Check(rounding != BI_ROUND_TRUNC || IsPlusZero(big::Div(big::Integer(3), big::Integer(-5))), "Div of 3 / -5");
+	}
+}
+
+struct Case {
+
+	const char* Name;
+	void (*Run)();
+};
+
+int main() {
+
+	const Case cases[] = {
+
+		{ "Schonhage-Strassen multiplication", CheckSchonhageStrassen },
+		{ "Number-theoretic transform multiplication", CheckNumberTheoreticTransform },
+		{ "Squaring", CheckSquaring },
+		{ "Toom-Cook 4, 6 and 8-Way multiplication", CheckToomCookHigherOrders },
+		{ "Unbalanced multiplication", CheckUnbalanced },
+		{ "In-place schoolbook multiplication", CheckInPlaceBasecase },
+		{ "BMI2/ADX multiply-accumulate kernel", CheckADXKernel },
+		{ "Schoolbook division", CheckSchoolbookDivision },
+		{ "Burnikel-Ziegler division", CheckBurnikelZiegler },
+		{ "Newton division", CheckNewton },
+		{ "Prepared divisor", CheckDivisor },
+		{ "Montgomery multiplication and PowMod", CheckMontgomery },
+		{ "Fixed-base exponentiation", CheckFixedBasePow },
+		{ "Parallel multiplication", CheckParallel },
+		{ "Exact division", CheckDivExact },
+		{ "Division with rounding", CheckRoundedDivision },
+		{ "Decimal ToString", CheckToString },
+		{ "Decimal FromString", CheckFromString },
+		{ "Bases 2 to 36 and stream flags", CheckBases },
+		{ "Decimal digit kernels", CheckDigitKernels },
+		{ "to_chars, from_chars and DigitCount", CheckCharConversions },
+		{ "Signs of zero results", CheckZeroSigns },
+	};
+
+	std::size_t failed = 0;
+	for (const Case& c : cases) {
+
+		s_Failures = 0;
+		c.Run();
+
+		std::cout << (s_Failures == 0 ? "ok      " : "FAILED  ") << c.Name << "\n";
+		if (s_Failures != 0)
+			failed++;
+	}
+
+	std::cout << "\n" << failed << " of " << sizeof(cases) / sizeof(cases[0]) << " cases failed\n";
+
+	return failed == 0 ? 0 : 1;
+}
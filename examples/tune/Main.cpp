@@ -0,0 +1,194 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <limits>
+#include <string>
+
+#include <BigInteger.hpp>
+
+// Every size is timed this many times, keeping the fastest run
+constexpr int RUNS = 5;
+
+// Every run repeats the product until it lasts at least this long (in microseconds)
+constexpr double MIN_RUN_TIME = 2000.0;
+
+// A threshold is accepted when the faster algorithm wins this many consecutive sizes
+constexpr std::size_t MIN_WINS = 2;
+
+class Timer {
+
+public:
+
+	Timer() {
+
+		start_time = std::chrono::high_resolution_clock::now();
+	}
+
+	void reset() {
+
+		start_time = std::chrono::high_resolution_clock::now();
+	}
+
+	double elapsedMicroseconds() const {
+
+		auto end_time = std::chrono::high_resolution_clock::now();
+		std::chrono::duration<double, std::micro> duration = end_time - start_time;
+		return duration.count();
+	}
+
+private:
+
+	std::chrono::high_resolution_clock::time_point start_time;
+};
+
+static double TimeOperation(const big::Integer& a, const big::Integer& b, bool division) {
+
+	double best = std::numeric_limits<double>::max();
+	for (int run = 0; run < RUNS; run++) {
+
+		std::size_t count = 0;
+		double time = 0.0;
+		Timer timer;
+		while (time < MIN_RUN_TIME) {
+
+			if (division)
+				a / b;
+			else
+				a * b;
+			count++;
+			time = timer.elapsedMicroseconds();
+		}
+
+		best = std::min(best, time / count);
+	}
+
+	return best;
+}
+
+/// <summary>
+/// Finds the smallest limb size from which the given algorithm is faster than the ones below it. Every size is measured twice: with the
+/// threshold one limb above it (so the operation skips the algorithm) and with the threshold equal to it (so only the top level uses it)
+/// </summary>
+/// <param name="name">The algorithm name to print</param>
+/// <param name="algorithm">The algorithm (BI_KARATSUBA, BI_TOOM_COOK_3, ...)</param>
+/// <param name="from">The first size to try in limbs</param>
+/// <param name="to">The last size to try in limbs, which is also returned if the algorithm never wins</param>
+/// <param name="division">True to divide a number twice as long by one of the given size, false to multiply two numbers of the given size</param>
+/// <returns>The threshold in limbs</returns>
+static std::size_t FindThreshold(const char* name, int algorithm, std::size_t from, std::size_t to, bool division = false) {
+
+	std::cout << "\n--- " << name << " ---\n";
+
+	std::size_t wins = 0;
+	std::size_t threshold = to;
+	for (std::size_t limbs = from; limbs <= to; limbs += std::max<std::size_t>(limbs / 8, 1)) {
+
+		big::Integer a(0, (division ? 2 : 1) * limbs * 64);
+		big::Integer::Rand(a);
+		big::Integer b(0, limbs * 64);
+		big::Integer::Rand(b);
+
+		big::Integer::SetThreshold(algorithm, limbs + 1);
+		const double before = TimeOperation(a, b, division);
+		big::Integer::SetThreshold(algorithm, limbs);
+		const double after = TimeOperation(a, b, division);
+
+		std::cout << limbs << " limbs: " << before << (char)230 << "s -> " << after << (char)230 << "s\n";
+
+		if (after < before) {
+
+			if (wins == 0)
+				threshold = limbs;
+
+			if (++wins == MIN_WINS)
+				break;
+		}
+
+		else {
+
+			wins = 0;
+			threshold = to;
+		}
+	}
+
+	big::Integer::SetThreshold(algorithm, threshold);
+	std::cout << "Threshold: " << threshold << " limbs\n";
+
+	return threshold;
+}
+
+static void WriteDefine(std::ofstream& fout, const char* name, std::size_t value) {
+
+	fout << "\n#ifndef " << name << "\n";
+	// SIZE_MAX turns off an algorithm that never won in the measured range
+	fout << "\t#define " << name << " ";
+	if (value == std::numeric_limits<std::size_t>::max())
+		fout << "SIZE_MAX\n";
+	else
+		fout << value << "\n";
+	fout << "#endif\n";
+}
+
+int main(int argc, char** argv) {
+
+	const std::string path = argc > 1 ? argv[1] : "Thresholds.hpp";
+	constexpr std::size_t never = std::numeric_limits<std::size_t>::max();
+
+	// The tiers are measured from the bottom up, with the ones above the current tier turned off
+	big::Integer::SetThreadCount(1);
+	big::Integer::SetNTTMode(BI_NTT_OFF);
+	big::Integer::SetThreshold(BI_SSA, never);
+	big::Integer::SetThreshold(BI_TOOM_COOK_3, never);
+	big::Integer::SetThreshold(BI_TOOM_COOK_4, never);
+	big::Integer::SetThreshold(BI_TOOM_COOK_6, never);
+	big::Integer::SetThreshold(BI_TOOM_COOK_8, never);
+
+	const std::size_t karatsuba = FindThreshold("Karatsuba", BI_KARATSUBA, 8, 4096);
+	const std::size_t toom3 = FindThreshold("Toom-Cook 3-Way", BI_TOOM_COOK_3, karatsuba, karatsuba * 16);
+	const std::size_t toom4 = FindThreshold("Toom-Cook 4-Way", BI_TOOM_COOK_4, toom3, toom3 * 16);
+	const std::size_t toom6 = FindThreshold("Toom-Cook 6-Way", BI_TOOM_COOK_6, toom4, toom4 * 16);
+	const std::size_t toom8 = FindThreshold("Toom-Cook 8-Way", BI_TOOM_COOK_8, toom6, toom6 * 16);
+
+	// The Schonhage-Strassen algorithm is measured without the number-theoretic transform, which is checked first in automatic mode
+	const std::size_t ssa = FindThreshold("Schonhage-Strassen", BI_SSA, 64, 65536);
+	big::Integer::SetNTTMode(BI_NTT_AUTO);
+	std::size_t ntt = FindThreshold("Number-theoretic transform", BI_NTT, 64, 65536);
+
+	// Without a crossover in the measured range the transform is not switched on at the range ceiling, where it never won, but left to
+	// BI_NTT_ON and explicit thresholds
+	if (ntt == 65536) {
+
+		ntt = never;
+		big::Integer::SetThreshold(BI_NTT, ntt);
+		std::cout << "No crossover: the number-theoretic transform stays opt-in\n";
+	}
+
+	// The division runs on top of the tuned multiplication. Newton's method is used for divisors that come back, as the repeated divisions here
+	const std::size_t burnikelZiegler = FindThreshold("Burnikel-Ziegler", BI_BURNIKEL_ZIEGLER, 8, 4096, true);
+	const std::size_t newton = FindThreshold("Newton", BI_NEWTON, burnikelZiegler * 16, 65536, true);
+
+	std::ofstream fout(path);
+	if (!fout.is_open()) {
+
+		std::cout << "\nCannot write " << path << "\n";
+		return -1;
+	}
+
+	fout << "#pragma once\n\n";
+	fout << "// The multiplication and division thresholds in limbs. This file can be regenerated with the tune program, which measures them on the host machine\n";
+	fout << "// (every value can be overridden at compile time, and SIZE_MAX marks an algorithm that never won in the measured range)\n";
+	WriteDefine(fout, "BI_KARATSUBA_THRESHOLD", karatsuba);
+	WriteDefine(fout, "BI_TOOM_COOK_3_THRESHOLD", toom3);
+	WriteDefine(fout, "BI_TOOM_COOK_4_THRESHOLD", toom4);
+	WriteDefine(fout, "BI_TOOM_COOK_6_THRESHOLD", toom6);
+	WriteDefine(fout, "BI_TOOM_COOK_8_THRESHOLD", toom8);
+	WriteDefine(fout, "BI_SSA_THRESHOLD", ssa);
+	WriteDefine(fout, "BI_NTT_THRESHOLD", ntt);
+	WriteDefine(fout, "BI_BURNIKEL_ZIEGLER_THRESHOLD", burnikelZiegler);
+	WriteDefine(fout, "BI_NEWTON_THRESHOLD", newton);
+	fout.close();
+
+	std::cout << "\nThe thresholds have been written to " << path << ": copy it to src/Thresholds.hpp and rebuild the library to use them\n";
+
+	return 0;
+}
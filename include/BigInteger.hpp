@@ -4,6 +4,10 @@
 #include <ostream>
 #include <string>
 #include <limits>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <system_error>
 
 #undef BI_PRINT_DEBUG_INFO
 //#define BI_PRINT_DEBUG_INFO
@@ -91,6 +95,28 @@
 #define BI_MAX_WORD std::numeric_limits<WORD>::max()
 #define BI_MAX_HALFWORD std::numeric_limits<HALFWORD>::max()
 
+// Number-theoretic transform multiplication modes
+#define BI_NTT_AUTO 0
+#define BI_NTT_ON 1
+#define BI_NTT_OFF 2
+
+// Multiplication and division algorithms with a limb threshold
+#define BI_KARATSUBA 0
+#define BI_TOOM_COOK_3 1
+#define BI_TOOM_COOK_4 2
+#define BI_TOOM_COOK_6 3
+#define BI_TOOM_COOK_8 4
+#define BI_NTT 5
+#define BI_SSA 6
+#define BI_PARALLEL 7
+#define BI_BURNIKEL_ZIEGLER 8
+#define BI_NEWTON 9
+
+// Division rounding modes
+#define BI_ROUND_TRUNC 0
+#define BI_ROUND_FLOOR 1
+#define BI_ROUND_CEIL 2
+
 // The big integer base structure type
 class BI_API BigInt_T {
 
@@ -118,8 +144,83 @@ public:
 	WORD SNO;
 };
 
+// The prepared divisor structure type
+class BI_API Divisor_T {
+
+public:
+
+	// The divisor
+	BigInt_T Value;
+
+	// The divisor magnitude shifted to the left until its most significant bit is set
+	BigInt_T Normalized;
+
+	// The normalization shift in bits
+	std::size_t Shift;
+
+	// The reciprocal of the most significant word of the normalized divisor
+	WORD WordReciprocal;
+
+	// The reciprocal of the divisor magnitude, 2^Precision / |Value| (only for huge divisors, otherwise Precision is 0)
+	BigInt_T Reciprocal;
+	std::size_t Precision;
+};
+
+// The Montgomery context structure type
+class BI_API Montgomery_T {
+
+public:
+
+	// The odd modulus, prepared for the reductions of the numbers that are not below it yet
+	Divisor_T Modulus;
+
+	// The modulus size in words (the Montgomery radix is R = 2^(word bits * Size))
+	std::size_t Size;
+
+	// -Modulus^-1 mod 2^(word bits)
+	WORD Inverse;
+
+	// R^2 mod Modulus, to convert a number into the Montgomery form with a single Montgomery multiplication
+	BigInt_T R2;
+};
+
+// The fixed-base exponentiation table structure type
+class BI_API FixedBase_T {
+
+public:
+
+	// The Montgomery context of the modulus
+	Montgomery_T Context;
+
+	// The base, reduced modulo the modulus
+	BigInt_T Base;
+
+	// The comb teeth (the table has 2^Teeth - 1 entries)
+	std::size_t Teeth;
+
+	// The exponent bits between two teeth
+	std::size_t Spacing;
+
+	// The exponent bits covered by the table (Teeth * Spacing)
+	std::size_t ExponentBits;
+
+	// The entries in the Montgomery form, Context.Size words each: entry j - 1 is the product of base^(2^(Spacing * i)) over the bits i set in j
+	BigInt_T Table;
+};
+
 namespace big {
 
+	class Integer;
+	struct to_chars_result;
+	struct from_chars_result;
+
+	// Declared ahead of big::Integer, which befriends it (see the definition below big::Mod)
+	template <
+		typename T,
+		typename = typename std::enable_if<std::is_integral<T>::value>::type
+	>
+	T ModWord(const big::Integer& n, T d, int rounding = BI_ROUND_TRUNC);
+
 	/// <summary>
 	/// The class that represents an integer without overflow or underflow
 	/// </summary>
@@ -139,6 +240,99 @@ namespace big {
 		/// <param name="n">The desired number (must already have a size)</param>
 		static void Rand(big::Integer& n);
 
+		/// <summary>
+		/// Squares a big integer. It is faster than multiplying the number by itself
+		/// </summary>
+		/// <param name="n">The number to square</param>
+		/// <returns>The square of the number</returns>
+		static big::Integer Square(const big::Integer& n);
+
+		/// <summary>
+		/// Computes the reciprocal of a big integer as a fixed-point number with Newton's method. The last reciprocals are cached, so a
+		/// divisor that is used again (by this function or by the division) does not need a new one
+		/// </summary>
+		/// <param name="n">The number to invert</param>
+		/// <param name="precision_bits">The fixed-point precision in bits</param>
+		/// <returns>2^precision_bits / n, rounded toward zero</returns>
+		static big::Integer Reciprocal(const big::Integer& n, std::size_t precision_bits);
+
+		/// <summary>
+		/// Sets how many divisors keep their reciprocal for the next divisions
+		/// </summary>
+		/// <param name="entries">The number of cached reciprocals (0 to disable the cache and free its memory)</param>
+		static void SetReciprocalCacheSize(std::size_t entries);
+
+		/// <returns>The number of cached reciprocals</returns>
+		static std::size_t GetReciprocalCacheSize();
+
+		/// <summary>
+		/// Sets the limb size from which the multiplication switches to the Schonhage-Strassen algorithm (a limb is an OS word)
+		/// </summary>
+		/// <param name="limbs">The desired threshold (both factors must reach it, values lower than 64 are raised to 64)</param>
+		static void SetSSAThreshold(std::size_t limbs);
+
+		/// <returns>The limb size from which the multiplication switches to the Schonhage-Strassen algorithm (a limb is an OS word)</returns>
+		static std::size_t GetSSAThreshold();
+
+		/// <summary>
+		/// Sets the number-theoretic transform multiplication mode
+		/// </summary>
+		/// <param name="mode">BI_NTT_AUTO to select it by size, BI_NTT_ON to always use it, BI_NTT_OFF to never use it</param>
+		static void SetNTTMode(int mode);
+
+		/// <returns>The number-theoretic transform multiplication mode (BI_NTT_AUTO, BI_NTT_ON or BI_NTT_OFF)</returns>
+		static int GetNTTMode();
+
+		/// <summary>
+		/// Sets the limb size from which the multiplication switches to the number-theoretic transform in automatic mode (a limb is an OS word)
+		/// </summary>
+		/// <param name="limbs">The desired threshold (both factors must reach it)</param>
+		static void SetNTTThreshold(std::size_t limbs);
+
+		/// <returns>The limb size from which the multiplication switches to the number-theoretic transform in automatic mode (a limb is an OS word)</returns>
+		static std::size_t GetNTTThreshold();
+
+		/// <summary>
+		/// Allows or forbids the BMI2/ADX multiply-accumulate kernel under the schoolbook multiplication. It is allowed by default and only used
+		/// where the processor supports it, while the portable kernel is used everywhere else
+		/// </summary>
+		/// <param name="enabled">True to use the kernel where the processor supports it, false to always use the portable one</param>
+		static void SetADXKernel(bool enabled);
+
+		/// <returns>True if the multiplication uses the BMI2/ADX kernel (it is allowed and the processor supports it)</returns>
+		static bool GetADXKernel();
+
+		/// <summary>
+		/// Sets the number of threads used by the multiplication. The top recursion levels of huge products are split among them (the setting
+		/// must not be changed while a multiplication is running)
+		/// </summary>
+		/// <param name="threads">The desired number of threads (1 to keep the multiplication serial, which is the default, 0 to use all the hardware threads)</param>
+		static void SetThreadCount(std::size_t threads);
+
+		/// <returns>The number of threads used by the multiplication</returns>
+		static std::size_t GetThreadCount();
+
+		/// <summary>
+		/// Sets the limb size from which the multiplication is split among the threads (a limb is an OS word)
+		/// </summary>
+		/// <param name="limbs">The desired threshold (both factors must reach it, values lower than 8 are raised to 8)</param>
+		static void SetParallelThreshold(std::size_t limbs);
+
+		/// <returns>The limb size from which the multiplication is split among the threads (a limb is an OS word)</returns>
+		static std::size_t GetParallelThreshold();
+
+		/// <summary>
+		/// Sets the limb size from which the multiplication or the division switches to the given algorithm (a limb is an OS word). The defaults come from
+		/// src/Thresholds.hpp, which can be regenerated for the host machine with the tune program
+		/// </summary>
+		/// <param name="algorithm">BI_KARATSUBA, BI_TOOM_COOK_3, BI_TOOM_COOK_4, BI_TOOM_COOK_6, BI_TOOM_COOK_8, BI_NTT, BI_SSA, BI_PARALLEL, BI_BURNIKEL_ZIEGLER or BI_NEWTON</param>
+		/// <param name="limbs">The desired threshold (both factors, or the divisor and the quotient, must reach it, values lower than 8 are raised to 8 for the Karatsuba algorithm, values lower than 2 are raised to 2 for the Burnikel-Ziegler algorithm and Newton's method)</param>
+		static void SetThreshold(int algorithm, std::size_t limbs);
+
+		/// <param name="algorithm">BI_KARATSUBA, BI_TOOM_COOK_3, BI_TOOM_COOK_4, BI_TOOM_COOK_6, BI_TOOM_COOK_8, BI_NTT, BI_SSA, BI_PARALLEL, BI_BURNIKEL_ZIEGLER or BI_NEWTON</param>
+		/// <returns>The limb size from which the multiplication or the division switches to the given algorithm (a limb is an OS word)</returns>
+		static std::size_t GetThreshold(int algorithm);
+
 		template <
 			typename T,
 			typename = typename std::enable_if<std::is_integral<T>::value>::type
@@ -165,14 +359,23 @@ namespace big {
 		/// </summary>
 		/// <param name="data">The converted big integer</param>
 		/// <param name="str">The string to convert that represents a number</param>
-		/// <returns>True if the conversion succeeds, false if there is at least one character that is not a digit (exception made for the minus sign at the beginning)</returns>
-		static bool FromString(Integer& data, const std::string& str);
+		/// <param name="base">The base, from 2 to 36 (the digits above 9 are letters in any case). It throws std::invalid_argument if it is out of range</param>
+		/// <returns>True if the conversion succeeds, false if there is at least one character that is not a digit of the base (exception made for the minus sign at the beginning)</returns>
+		static bool FromString(Integer& data, const std::string& str, int base = 10);
 
 		/// <summary>
 		/// Converts a big integer into a string
 		/// </summary>
+		/// <param name="base">The base, from 2 to 36 (the digits above 9 are lowercase letters). It throws std::invalid_argument if it is out of range</param>
 		/// <returns>The big integer as a string</returns>
-		std::string ToString() const;
+		std::string ToString(int base = 10) const;
+
+		/// <summary>
+		/// Counts the digits of the big integer, so that a buffer for big::to_chars can be sized exactly
+		/// </summary>
+		/// <param name="base">The base, from 2 to 36. It throws std::invalid_argument if it is out of range</param>
+		/// <returns>The number of digits, without the minus sign</returns>
+		std::size_t DigitCount(int base = 10) const;
 
 		/// <returns>The raw big integer allocator</returns>
 		const void* Data();
@@ -209,6 +412,33 @@ namespace big {
 		friend BI_API const big::Integer operator/(const big::Integer& a, const big::Integer& b);
 		friend BI_API const big::Integer operator%(const big::Integer& a, const big::Integer& b);
 
+		// Arithmetic operators with a native divisor, which divide with a single pass over the words instead of converting the divisor
+
+		template <
+			typename T,
+			typename = typename std::enable_if<std::is_integral<T>::value>::type
+		>
+		friend const big::Integer operator/(const big::Integer& a, T b) {
+
+			big::Integer num(a);
+			DivWord(num, NativeMagnitude(b), IsNativeNegative(b));
+
+			return num;
+		}
+
+		/// <returns>The remainder with the sign of the dividend, like the big integer operator% (see big::ModWord for a native remainder)</returns>
+		template <
+			typename T,
+			typename = typename std::enable_if<std::is_integral<T>::value>::type
+		>
+		friend const big::Integer operator%(const big::Integer& a, T b) {
+
+			big::Integer num;
+			ModWord(a, NativeMagnitude(b), &num);
+
+			return num;
+		}
+
 		// Relational and comparison operators
 
 		friend BI_API const bool operator==(const big::Integer& a, const big::Integer& b);
@@ -240,6 +470,29 @@ namespace big {
 		friend BI_API big::Integer& operator*=(big::Integer& a, const big::Integer& b);
 		friend BI_API big::Integer& operator/=(big::Integer& a, const big::Integer& b);
 		friend BI_API big::Integer& operator%=(big::Integer& a, const big::Integer& b);
+
+		template <
+			typename T,
+			typename = typename std::enable_if<std::is_integral<T>::value>::type
+		>
+		friend big::Integer& operator/=(big::Integer& a, T b) {
+
+			DivWord(a, NativeMagnitude(b), IsNativeNegative(b));
+
+			return a;
+		}
+
+		template <
+			typename T,
+			typename = typename std::enable_if<std::is_integral<T>::value>::type
+		>
+		friend big::Integer& operator%=(big::Integer& a, T b) {
+
+			ModWord(a, NativeMagnitude(b), &a);
+
+			return a;
+		}
+
 		friend BI_API big::Integer& operator&=(big::Integer& a, const big::Integer& b);
 		friend BI_API big::Integer& operator|=(big::Integer& a, const big::Integer& b);
 		friend BI_API big::Integer& operator^=(big::Integer& a, const big::Integer& b);
@@ -261,7 +514,295 @@ namespace big {
 
 		void InitFromInt(WORD n, bool sign, std::size_t capacity);
 
+		template <typename T>
+		static bool IsNativeNegative(T n) {
+
+			return std::is_signed<T>::value && (std::int64_t)n < 0;
+		}
+
+		template <typename T>
+		static std::uint64_t NativeMagnitude(T n) {
+
+			return IsNativeNegative(n) ? 0 - (std::uint64_t)(std::int64_t)n : (std::uint64_t)n;
+		}
+
+		/// <summary>
+		/// Divides a big integer by a native divisor, one word at a time with the precomputed reciprocal of the divisor
+		/// </summary>
+		/// <param name="n">The dividend, where the quotient (rounded toward zero) will be stored</param>
+		/// <param name="d">The divisor's magnitude (it cannot be zero)</param>
+		/// <param name="negative">True if the divisor is negative</param>
+		/// <returns>The remainder's magnitude</returns>
+		static std::uint64_t DivWord(big::Integer& n, std::uint64_t d, bool negative);
+
+		/// <summary>
+		/// Computes the remainder of the division of a big integer by a native divisor, without storing the quotient
+		/// </summary>
+		/// <param name="n">The dividend</param>
+		/// <param name="d">The divisor's magnitude (it cannot be zero)</param>
+		/// <param name="remainder">The remainder with the sign of the dividend (nullptr if not needed, it can be the dividend itself)</param>
+		/// <returns>The remainder's magnitude</returns>
+		static std::uint64_t ModWord(const big::Integer& n, std::uint64_t d, big::Integer* remainder = nullptr);
+
 		// Big integer data structure
 		BigInt_T m_Data;
+
+		friend class Divisor;
+		friend class MontgomeryContext;
+		friend class FixedBasePow;
+		friend BI_API big::Integer PowMod(const big::Integer& base, const big::Integer& exp, const big::Integer& mod);
+		friend BI_API big::Integer DivExact(const big::Integer& n, const big::Integer& d);
+		friend BI_API void DivMod(const big::Integer& a, const big::Integer& b, big::Integer& quotient, big::Integer& remainder, int rounding);
+		friend BI_API big::Integer Div(const big::Integer& a, const big::Integer& b, int rounding);
+		template <typename T, typename U> friend T big::ModWord(const big::Integer& n, T d, int rounding);
+		friend BI_API big::Integer Mod(const big::Integer& a, const big::Integer& b, int rounding);
+		friend BI_API to_chars_result to_chars(char* first, char* last, const big::Integer& value, int base);
+		friend BI_API from_chars_result from_chars(const char* first, const char* last, big::Integer& value, int base);
 	};
+
+	/// <summary>
+	/// A divisor prepared for many divisions by the same value. The normalization shift and the reciprocal of the top word (for huge divisors,
+	/// the Barrett reciprocal of the whole divisor) are computed once, so every division only does the work that depends on the dividend
+	/// </summary>
+	class BI_API Divisor {
+
+	public:
+
+		/// <param name="divisor">The divisor (it cannot be zero)</param>
+		Divisor(const big::Integer& divisor);
+
+		/// <param name="n">The dividend</param>
+		/// <returns>The quotient rounded toward zero, like operator/</returns>
+		big::Integer Div(const big::Integer& n) const;
+
+		/// <param name="n">The dividend</param>
+		/// <returns>The remainder with the sign of the dividend, like operator%</returns>
+		big::Integer Mod(const big::Integer& n) const;
+
+		/// <summary>
+		/// Computes the quotient and the remainder with a single division
+		/// </summary>
+		/// <param name="n">The dividend</param>
+		/// <param name="quotient">The quotient rounded toward zero</param>
+		/// <param name="remainder">The remainder with the sign of the dividend</param>
+		void DivMod(const big::Integer& n, big::Integer& quotient, big::Integer& remainder) const;
+
+		/// <returns>The divisor</returns>
+		big::Integer Value() const;
+
+	private:
+
+		// Prepared divisor data structure
+		Divisor_T m_Data;
+	};
+
+	/// <summary>
+	/// A context for the modular multiplication with Montgomery's reduction (REDC) by an odd modulus. The numbers are kept in the Montgomery
+	/// form aR mod m, where the product of two of them is reduced with word multiplications and shifts instead of a division
+	/// </summary>
+	class BI_API MontgomeryContext {
+
+	public:
+
+		/// <param name="modulus">The modulus (it must be odd, its sign is ignored)</param>
+		MontgomeryContext(const big::Integer& modulus);
+
+		/// <param name="n">The number to convert (it is reduced modulo the modulus first)</param>
+		/// <returns>The number in the Montgomery form, nR mod m</returns>
+		big::Integer ToMontgomery(const big::Integer& n) const;
+
+		/// <param name="n">The number in the Montgomery form</param>
+		/// <returns>The number it represents, between 0 and the modulus</returns>
+		big::Integer FromMontgomery(const big::Integer& n) const;
+
+		/// <summary>
+		/// Multiplies two numbers in the Montgomery form. The operands outside [0, m) are reduced first
+		/// </summary>
+		/// <param name="a">The first factor in the Montgomery form</param>
+		/// <param name="b">The second factor in the Montgomery form</param>
+		/// <returns>The product in the Montgomery form, abR^-1 mod m</returns>
+		big::Integer Mult(const big::Integer& a, const big::Integer& b) const;
+
+		/// <summary>
+		/// Squares a number in the Montgomery form. It is faster than multiplying the number by itself
+		/// </summary>
+		/// <param name="a">The number in the Montgomery form</param>
+		/// <returns>The square in the Montgomery form, a^2R^-1 mod m</returns>
+		big::Integer Square(const big::Integer& a) const;
+
+		/// <param name="base">The base (it is reduced modulo the modulus first)</param>
+		/// <param name="exp">The exponent (it cannot be negative)</param>
+		/// <returns>base^exp mod m, between 0 and the modulus</returns>
+		big::Integer Pow(const big::Integer& base, const big::Integer& exp) const;
+
+		/// <returns>The modulus</returns>
+		big::Integer Modulus() const;
+
+	private:
+
+		// Montgomery context data structure
+		Montgomery_T m_Data;
+	};
+
+	/// <summary>
+	/// A modular exponentiation with a fixed base and modulus (for example a generator), which precomputes a Lim-Lee comb of powers of the base
+	/// once. An exponent of b bits then costs about b / teeth squarings and as many multiplications in the Montgomery form, with no table built
+	/// per call
+	/// </summary>
+	class BI_API FixedBasePow {
+
+	public:
+
+		/// <param name="base">The base</param>
+		/// <param name="mod">The modulus (it must be odd, its sign is ignored)</param>
+		/// <param name="exp_bits">The longest exponent in bits that the table covers (0 for the modulus bits). Longer exponents still work, at the speed of PowMod</param>
+		/// <param name="teeth">The comb teeth, between 1 and 16 (0 to choose them from the exponent bits). Every extra tooth doubles the table and shortens the exponentiation</param>
+		FixedBasePow(const big::Integer& base, const big::Integer& mod, std::size_t exp_bits = 0, std::size_t teeth = 0);
+
+		/// <param name="exp">The exponent (it cannot be negative)</param>
+		/// <returns>base^exp mod |mod|, between 0 and the modulus</returns>
+		big::Integer Pow(const big::Integer& exp) const;
+
+		/// <returns>The memory used by the precomputed table in bytes</returns>
+		std::size_t MemoryUsage() const;
+
+		/// <returns>The comb teeth</returns>
+		std::size_t Teeth() const;
+
+		/// <returns>The longest exponent in bits that the table covers</returns>
+		std::size_t ExponentBits() const;
+
+	private:
+
+		// Fixed-base table data structure
+		FixedBase_T m_Data;
+	};
+
+	/// <summary>
+	/// Computes a modular power with the sliding window method. An odd modulus multiplies in the Montgomery form, an even one reduces every
+	/// product with a prepared divisor
+	/// </summary>
+	/// <param name="base">The base</param>
+	/// <param name="exp">The exponent (it cannot be negative)</param>
+	/// <param name="mod">The modulus (it cannot be zero, its sign is ignored)</param>
+	/// <returns>base^exp mod |mod|, between 0 and the modulus</returns>
+	BI_API big::Integer PowMod(const big::Integer& base, const big::Integer& exp, const big::Integer& mod);
+
+	/// <summary>
+	/// Divides two big integers when the division is known to be exact. When the divisor or the quotient is short, the quotient is computed
+	/// from its least significant word with Jebelean's 2-adic method, which never needs the remainder. If the division is not exact, the
+	/// result is meaningless
+	/// </summary>
+	/// <param name="n">The dividend (a multiple of the divisor)</param>
+	/// <param name="d">The divisor (it cannot be zero)</param>
+	/// <returns>The quotient n / d</returns>
+	BI_API big::Integer DivExact(const big::Integer& n, const big::Integer& d);
+
+	/// <summary>
+	/// Computes the quotient and the remainder with a single division, storing them in the given big integers. With the floor rounding the
+	/// remainder has the sign of the divisor, with the ceiling rounding the opposite one
+	/// </summary>
+	/// <param name="a">The dividend</param>
+	/// <param name="b">The divisor (it cannot be zero)</param>
+	/// <param name="quotient">The quotient (it can be the dividend or the divisor itself)</param>
+	/// <param name="remainder">The remainder, such that a = quotient * b + remainder (it can be the dividend or the divisor itself, but not the quotient)</param>
+	/// <param name="rounding">BI_ROUND_TRUNC to round the quotient toward zero (like operator/ and operator%), BI_ROUND_FLOOR toward negative infinity or BI_ROUND_CEIL toward positive infinity</param>
+	BI_API void DivMod(const big::Integer& a, const big::Integer& b, big::Integer& quotient, big::Integer& remainder, int rounding = BI_ROUND_TRUNC);
+
+	/// <param name="a">The dividend</param>
+	/// <param name="b">The divisor (it cannot be zero)</param>
+	/// <param name="rounding">BI_ROUND_TRUNC, BI_ROUND_FLOOR or BI_ROUND_CEIL (see DivMod)</param>
+	/// <returns>The quotient a / b with the given rounding</returns>
+	BI_API big::Integer Div(const big::Integer& a, const big::Integer& b, int rounding = BI_ROUND_TRUNC);
+
+	/// <summary>
+	/// Computes the remainder of a division without storing the quotient
+	/// </summary>
+	/// <param name="a">The dividend</param>
+	/// <param name="b">The divisor (it cannot be zero)</param>
+	/// <param name="rounding">BI_ROUND_TRUNC, BI_ROUND_FLOOR or BI_ROUND_CEIL (see DivMod)</param>
+	/// <returns>The remainder of a / b with the given rounding</returns>
+	BI_API big::Integer Mod(const big::Integer& a, const big::Integer& b, int rounding = BI_ROUND_TRUNC);
+
+	/// <summary>
+	/// Computes the remainder of the division by a native divisor as a native integer, with a single pass over the words and without storing
+	/// the quotient. An unsigned divisor cannot hold the negative remainders of the other roundings, so it always gives the floor one, the
+	/// residue from 0 to d - 1 (so ModWord(x, 1000000007u) is a residue of a negative x too)
+	/// </summary>
+	/// <param name="n">The dividend</param>
+	/// <param name="d">The divisor (it cannot be zero)</param>
+	/// <param name="rounding">BI_ROUND_TRUNC, BI_ROUND_FLOOR or BI_ROUND_CEIL (see DivMod), ignored for an unsigned divisor</param>
+	/// <returns>The remainder of n / d with the given rounding, like big::Mod</returns>
+	template <typename T, typename>
+	T ModWord(const big::Integer& n, T d, int rounding) {
+
+		if (rounding != BI_ROUND_TRUNC && rounding != BI_ROUND_FLOOR && rounding != BI_ROUND_CEIL)
+			throw std::invalid_argument("Invalid rounding mode");
+
+		if (!std::is_signed<T>::value)
+			rounding = BI_ROUND_FLOOR;
+
+		const std::uint64_t m = big::Integer::NativeMagnitude(d);
+		const bool negative = big::Integer::IsNativeNegative(d);
+		std::uint64_t r = big::Integer::ModWord(n, m);
+		bool sign = n.m_Data.Sign == BI_MINUS_SIGN;
+
+		// The floor rounding gives the remainder the sign of the divisor, the ceiling rounding the opposite one
+		if (r != 0 && rounding != BI_ROUND_TRUNC && (sign != negative) == (rounding == BI_ROUND_FLOOR)) {
+
+			r = m - r;
+			sign = !sign;
+		}
+
+		if (r == 0)
+			return 0;
+
+		return sign ? (T)(0 - r) : (T)r;
+	}
+
+	/// <summary>
+	/// The result of big::to_chars, like std::to_chars_result
+	/// </summary>
+	struct to_chars_result {
+
+		// The end of the written characters, or last if the range is too short
+		char* ptr;
+
+		// std::errc() on success, std::errc::value_too_large if the range is too short
+		std::errc ec;
+	};
+
+	/// <summary>
+	/// The result of big::from_chars, like std::from_chars_result
+	/// </summary>
+	struct from_chars_result {
+
+		// The end of the number, or first if the range does not start with one
+		const char* ptr;
+
+		// std::errc() on success, std::errc::invalid_argument if the range does not start with a number
+		std::errc ec;
+	};
+
+	/// <summary>
+	/// Writes a big integer into a caller-owned buffer, like std::to_chars. The string is not terminated, and nothing is allocated below the
+	/// divide-and-conquer threshold (a buffer of big::Integer::DigitCount characters, plus one for the minus sign, is always enough)
+	/// </summary>
+	/// <param name="first">The start of the buffer</param>
+	/// <param name="last">The end of the buffer</param>
+	/// <param name="value">The big integer</param>
+	/// <param name="base">The base, from 2 to 36 (the digits above 9 are lowercase letters). It throws std::invalid_argument if it is out of range</param>
+	/// <returns>The end of the written characters and the error code</returns>
+	BI_API to_chars_result to_chars(char* first, char* last, const big::Integer& value, int base = 10);
+
+	/// <summary>
+	/// Reads the longest number at the start of a caller-owned buffer (an optional minus sign followed by digits), like std::from_chars. The
+	/// digits are read in place and nothing is allocated below the divide-and-conquer threshold, except the words that the big integer lacks
+	/// </summary>
+	/// <param name="first">The start of the buffer</param>
+	/// <param name="last">The end of the buffer</param>
+	/// <param name="value">The converted big integer (unchanged if the buffer does not start with a number)</param>
+	/// <param name="base">The base, from 2 to 36 (the digits above 9 are letters in any case). It throws std::invalid_argument if it is out of range</param>
+	/// <returns>The end of the number and the error code</returns>
+	BI_API from_chars_result from_chars(const char* first, const char* last, big::Integer& value, int base = 10);
 }
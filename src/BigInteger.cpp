@@ -1,6 +1,10 @@
+#include <algorithm>
 #include <cassert>
+#include <cctype>
 #include <cmath>
+#include <cstring>
 #include <random>
+#include <stdexcept>
 
 #include "Utils.hpp"
 
@@ -21,6 +25,102 @@ namespace big {
 			n.m_Data.Buffer[i] = WORD(rand());
 	}
 
+	big::Integer Integer::Square(const big::Integer& n) {
+
+		big::Integer num(n);
+		Utils::Square(num.m_Data);
+
+		return num;
+	}
+
+	big::Integer Integer::Reciprocal(const big::Integer& n, std::size_t precision_bits) {
+
+		big::Integer num(n);
+		Utils::Reciprocal(num.m_Data, precision_bits);
+
+		return num;
+	}
+
+	void Integer::SetReciprocalCacheSize(std::size_t entries) {
+
+		Utils::SetReciprocalCacheSize(entries);
+	}
+
+	std::size_t Integer::GetReciprocalCacheSize() {
+
+		return Utils::GetReciprocalCacheSize();
+	}
+
+	void Integer::SetSSAThreshold(std::size_t limbs) {
+
+		Utils::SetSSAThreshold(limbs);
+	}
+
+	std::size_t Integer::GetSSAThreshold() {
+
+		return Utils::GetSSAThreshold();
+	}
+
+	void Integer::SetNTTMode(int mode) {
+
+		Utils::SetNTTMode(mode);
+	}
+
+	int Integer::GetNTTMode() {
+
+		return Utils::GetNTTMode();
+	}
+
+	void Integer::SetNTTThreshold(std::size_t limbs) {
+
+		Utils::SetNTTThreshold(limbs);
+	}
+
+	std::size_t Integer::GetNTTThreshold() {
+
+		return Utils::GetNTTThreshold();
+	}
+
+	void Integer::SetADXKernel(bool enabled) {
+
+		Utils::SetADXKernel(enabled);
+	}
+
+	bool Integer::GetADXKernel() {
+
+		return Utils::GetADXKernel();
+	}
+
+	void Integer::SetThreadCount(std::size_t threads) {
+
+		Utils::SetThreadCount(threads);
+	}
+
+	std::size_t Integer::GetThreadCount() {
+
+		return Utils::GetThreadCount();
+	}
+
+	void Integer::SetParallelThreshold(std::size_t limbs) {
+
+		Utils::SetParallelThreshold(limbs);
+	}
+
+	std::size_t Integer::GetParallelThreshold() {
+
+		return Utils::GetParallelThreshold();
+	}
+
+	void Integer::SetThreshold(int algorithm, std::size_t limbs) {
+
+		Utils::SetThreshold(algorithm, limbs);
+	}
+
+	std::size_t Integer::GetThreshold(int algorithm) {
+
+		return Utils::GetThreshold(algorithm);
+	}
+
 	void Integer::InitFromInt(WORD n, bool sign, std::size_t size) {
 
 		size = (std::size_t)std::ceil((long double)size / (sizeof(WORD) * 8));
@@ -94,14 +194,15 @@ namespace big {
 
 	Integer& Integer::operator=(const Integer& other) {
 
-		if (Utils::IsOnStack(other.m_Data))
-			Utils::Copy(m_Data, other.m_Data);
-
-		else {
+		if (this == &other)
+			return *this;
 
+		if (!Utils::IsOnStack(other.m_Data))
 			Utils::Resize(m_Data, other.m_Data.Size);
-			Utils::Copy(m_Data, other.m_Data);
-		}
+
+		// Only the significant words are copied, so the ones left from the previous value must be cleared
+		memset(m_Data.Buffer, 0, m_Data.Size * sizeof(WORD));
+		Utils::Copy(m_Data, other.m_Data);
 
 		return *this;
 	}
@@ -118,14 +219,19 @@ namespace big {
 
 	Integer::~Integer() {}
 
-	bool Integer::FromString(Integer& data, const std::string& str) {
+	bool Integer::FromString(Integer& data, const std::string& str, int base) {
+
+		return Utils::FromString(data.m_Data, str, base);
+	}
+
+	std::string Integer::ToString(int base) const {
 
-		return Utils::FromString(data.m_Data, str);
+		return Utils::ToString(m_Data, base);
 	}
 
-	std::string Integer::ToString() const {
+	std::size_t Integer::DigitCount(int base) const {
 
-		return Utils::ToString(m_Data);
+		return Utils::CountDigits(m_Data, base);
 	}
 
 	const void* Integer::Data() {
@@ -161,7 +267,22 @@ namespace big {
 		std::string str;
 		is >> str;
 
-		if (!Integer::FromString(n, str))
+		// The base follows the stream flags: with none of them set, it is read from the prefix (0x for hexadecimal, 0 for octal)
+		const std::ios_base::fmtflags basefield = is.flags() & std::ios_base::basefield;
+		const std::size_t sign = !str.empty() && str[0] == '-';
+		const bool hexPrefix = str.length() > sign + 2 && str[sign] == '0' && (str[sign + 1] == 'x' || str[sign + 1] == 'X');
+		int base = 10;
+		if (basefield == std::ios_base::hex || (basefield == 0 && hexPrefix)) {
+
+			base = 16;
+			if (hexPrefix)
+				str.erase(sign, 2);
+		}
+
+		else if (basefield == std::ios_base::oct || (basefield == 0 && str.length() > sign + 1 && str[sign] == '0'))
+			base = 8;
+
+		if (!Integer::FromString(n, str, base))
 			is.setstate(std::ios_base::failbit);
 
 		return is;
@@ -169,7 +290,25 @@ namespace big {
 
 	BI_API std::ostream& operator<<(std::ostream& os, const big::Integer& n) {
 
-		return os << n.ToString();
+		const std::ios_base::fmtflags flags = os.flags();
+		const std::ios_base::fmtflags basefield = flags & std::ios_base::basefield;
+		const int base = basefield == std::ios_base::hex ? 16 : (basefield == std::ios_base::oct ? 8 : 10);
+
+		std::string str = n.ToString(base);
+		if (base == 16 && (flags & std::ios_base::uppercase))
+			std::transform(str.begin(), str.end(), str.begin(), [](char c) { return (char)std::toupper((unsigned char)c); });
+
+		// The prefix goes after the sign and, as for the native integers, zero has none
+		if (base != 10 && (flags & std::ios_base::showbase) && str != "0") {
+
+			const std::size_t sign = str[0] == '-';
+			if (base == 16)
+				str.insert(sign, (flags & std::ios_base::uppercase) ? "0X" : "0x");
+			else
+				str.insert(sign, "0");
+		}
+
+		return os << str;
 	}
 
 	// Arithmetic operators
@@ -209,10 +348,24 @@ namespace big {
 	BI_API const big::Integer operator%(const big::Integer& a, const big::Integer& b) {
 
 		big::Integer num(a);
-		big::Integer rem;
-		Utils::Div(num.m_Data, b.m_Data, &rem.m_Data);
+		Utils::Mod(num.m_Data, b.m_Data);
 
-		return rem;
+		return num;
+	}
+
+	std::uint64_t big::Integer::DivWord(big::Integer& n, std::uint64_t d, bool negative) {
+
+		const std::uint64_t r = Utils::DivWord(n.m_Data, d);
+
+		// Establish sign
+		n.m_Data.Sign = Utils::IsZero(n.m_Data) ? BI_PLUS_SIGN : n.m_Data.Sign ^ negative;
+
+		return r;
+	}
+
+	std::uint64_t big::Integer::ModWord(const big::Integer& n, std::uint64_t d, big::Integer* remainder) {
+
+		return Utils::ModWord(n.m_Data, d, remainder != nullptr ? &remainder->m_Data : nullptr);
 	}
 
 	// Relational and comparison operators
@@ -366,8 +519,7 @@ namespace big {
 
 	BI_API big::Integer& operator%=(big::Integer& a, const big::Integer& b) {
 
-		BigInt_T aCpy = a.m_Data;
-		Utils::Div(aCpy, b.m_Data, &a.m_Data);
+		Utils::Mod(a.m_Data, b.m_Data);
 
 		return a;
 	}
@@ -476,6 +628,224 @@ namespace big {
 
 		return cpy;
 	}
+
+	// Prepared divisor
+
+	Divisor::Divisor(const big::Integer& divisor) {
+
+		Utils::PrepareDivisor(m_Data, divisor.m_Data);
+	}
+
+	big::Integer Divisor::Div(const big::Integer& n) const {
+
+		big::Integer num(n);
+		Utils::Div(num.m_Data, m_Data);
+
+		return num;
+	}
+
+	big::Integer Divisor::Mod(const big::Integer& n) const {
+
+		big::Integer num(n);
+		big::Integer rem;
+		Utils::Div(num.m_Data, m_Data, &rem.m_Data);
+
+		return rem;
+	}
+
+	void Divisor::DivMod(const big::Integer& n, big::Integer& quotient, big::Integer& remainder) const {
+
+		BigInt_T num = n.m_Data;
+		Utils::Div(num, m_Data, &remainder.m_Data);
+
+		Utils::Resize(quotient.m_Data, Utils::CountSignificantWords(num));
+		Utils::Copy(quotient.m_Data, num);
+	}
+
+	big::Integer Divisor::Value() const {
+
+		big::Integer value;
+		Utils::Resize(value.m_Data, Utils::CountSignificantWords(m_Data.Value));
+		Utils::Copy(value.m_Data, m_Data.Value);
+
+		return value;
+	}
+
+	// Montgomery context
+
+	MontgomeryContext::MontgomeryContext(const big::Integer& modulus) {
+
+		Utils::PrepareMontgomery(m_Data, modulus.m_Data);
+	}
+
+	big::Integer MontgomeryContext::ToMontgomery(const big::Integer& n) const {
+
+		big::Integer num(n);
+		Utils::ToMontgomery(num.m_Data, m_Data);
+
+		return num;
+	}
+
+	big::Integer MontgomeryContext::FromMontgomery(const big::Integer& n) const {
+
+		big::Integer num(n);
+		Utils::FromMontgomery(num.m_Data, m_Data);
+
+		return num;
+	}
+
+	big::Integer MontgomeryContext::Mult(const big::Integer& a, const big::Integer& b) const {
+
+		big::Integer num(a);
+		Utils::MontgomeryMult(num.m_Data, b.m_Data, m_Data);
+
+		return num;
+	}
+
+	big::Integer MontgomeryContext::Square(const big::Integer& a) const {
+
+		big::Integer num(a);
+		Utils::MontgomerySquare(num.m_Data, m_Data);
+
+		return num;
+	}
+
+	big::Integer MontgomeryContext::Pow(const big::Integer& base, const big::Integer& exp) const {
+
+		big::Integer num(base);
+		Utils::MontgomeryPow(num.m_Data, exp.m_Data, m_Data);
+
+		return num;
+	}
+
+	big::Integer MontgomeryContext::Modulus() const {
+
+		big::Integer value;
+		Utils::Resize(value.m_Data, Utils::CountSignificantWords(m_Data.Modulus.Value));
+		Utils::Copy(value.m_Data, m_Data.Modulus.Value);
+
+		return value;
+	}
+
+	// Exact division
+
+	BI_API big::Integer DivExact(const big::Integer& n, const big::Integer& d) {
+
+		big::Integer num(n);
+		Utils::DivExact(num.m_Data, d.m_Data);
+
+		return num;
+	}
+
+	// Division with rounding
+
+	BI_API void DivMod(const big::Integer& a, const big::Integer& b, big::Integer& quotient, big::Integer& remainder, int rounding) {
+
+		if (&quotient == &remainder)
+			throw std::invalid_argument("The quotient and the remainder must be different big integers");
+
+		// The divisor is still needed after the quotient and the remainder are stored
+		BigInt_T divisorCpy;
+		const BigInt_T* divisor = &b.m_Data;
+		if (&b == &quotient || &b == &remainder) {
+
+			divisorCpy = b.m_Data;
+			divisor = &divisorCpy;
+		}
+
+		if (&a != &quotient) {
+
+			Utils::Resize(quotient.m_Data, Utils::CountSignificantWords(a.m_Data));
+			Utils::Copy(quotient.m_Data, a.m_Data);
+		}
+
+		Utils::Div(quotient.m_Data, *divisor, &remainder.m_Data);
+		Utils::RoundDivision(&quotient.m_Data, remainder.m_Data, *divisor, rounding);
+	}
+
+	BI_API big::Integer Div(const big::Integer& a, const big::Integer& b, int rounding) {
+
+		big::Integer num(a);
+		if (rounding == BI_ROUND_TRUNC)
+			Utils::Div(num.m_Data, b.m_Data);
+		else {
+
+			big::Integer rem;
+			Utils::Div(num.m_Data, b.m_Data, &rem.m_Data);
+			Utils::RoundDivision(&num.m_Data, rem.m_Data, b.m_Data, rounding);
+		}
+
+		return num;
+	}
+
+	BI_API big::Integer Mod(const big::Integer& a, const big::Integer& b, int rounding) {
+
+		big::Integer num(a);
+		Utils::Mod(num.m_Data, b.m_Data);
+		Utils::RoundDivision(nullptr, num.m_Data, b.m_Data, rounding);
+
+		return num;
+	}
+
+	// Fixed-base exponentiation
+
+	FixedBasePow::FixedBasePow(const big::Integer& base, const big::Integer& mod, std::size_t exp_bits, std::size_t teeth) {
+
+		Utils::PrepareFixedBase(m_Data, base.m_Data, mod.m_Data, exp_bits, teeth);
+	}
+
+	big::Integer FixedBasePow::Pow(const big::Integer& exp) const {
+
+		big::Integer num(exp);
+		Utils::FixedBasePow(num.m_Data, m_Data);
+
+		return num;
+	}
+
+	std::size_t FixedBasePow::MemoryUsage() const {
+
+		return m_Data.Table.Size * sizeof(WORD);
+	}
+
+	std::size_t FixedBasePow::Teeth() const {
+
+		return m_Data.Teeth;
+	}
+
+	std::size_t FixedBasePow::ExponentBits() const {
+
+		return m_Data.ExponentBits;
+	}
+
+	// Modular exponentiation
+
+	BI_API big::Integer PowMod(const big::Integer& base, const big::Integer& exp, const big::Integer& mod) {
+
+		big::Integer num(base);
+		Utils::PowMod(num.m_Data, exp.m_Data, mod.m_Data);
+
+		return num;
+	}
+
+	// Character conversion
+
+	BI_API to_chars_result to_chars(char* first, char* last, const big::Integer& value, int base) {
+
+		char* end = Utils::ToChars(first, last, value.m_Data, base);
+		if (end == nullptr)
+			return { last, std::errc::value_too_large };
+
+		return { end, std::errc() };
+	}
+
+	BI_API from_chars_result from_chars(const char* first, const char* last, big::Integer& value, int base) {
+
+		const char* end = Utils::FromChars(first, last, value.m_Data, base);
+		if (end == nullptr)
+			return { first, std::errc::invalid_argument };
+
+		return { end, std::errc() };
+	}
 }
 
 // --- Big integer structure ---
@@ -0,0 +1,170 @@
+#include "ThreadPool.hpp"
+
+namespace Utils {
+
+	// The pool that owns the calling thread and the index of its queue (nullptr for the threads outside any pool)
+	static thread_local const ThreadPool* t_Pool = nullptr;
+	static thread_local std::size_t t_QueueIndex = 0;
+
+	// --- Task group ---
+
+	ThreadPool::TaskGroup::TaskGroup(ThreadPool& pool)
+		: m_Pool(pool), m_Pending(0)
+	{}
+
+	ThreadPool::TaskGroup::~TaskGroup() {
+
+		try {
+
+			Wait();
+		}
+
+		catch (...) {}
+	}
+
+	void ThreadPool::TaskGroup::Run(std::function<void()> task) {
+
+		m_Pending++;
+		m_Pool.Push({ std::move(task), this });
+	}
+
+	void ThreadPool::TaskGroup::Wait() {
+
+		const std::size_t index = m_Pool.GetQueueIndex();
+		while (m_Pending.load() != 0)
+			if (!m_Pool.RunOne(index))
+				std::this_thread::yield();
+
+		std::exception_ptr exception;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			std::swap(exception, m_Exception);
+		}
+
+		if (exception)
+			std::rethrow_exception(exception);
+	}
+
+	// --- Thread pool ---
+
+	ThreadPool::ThreadPool(std::size_t threads)
+		: m_Queued(0), m_Stop(false)
+	{
+
+		const std::size_t workers = threads > 1 ? threads - 1 : 0;
+
+		// One queue per worker, plus one shared by the threads outside the pool
+		for (std::size_t i = 0; i <= workers; i++)
+			m_Queues.emplace_back(new Queue());
+
+		for (std::size_t i = 0; i < workers; i++)
+			m_Workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+	}
+
+	ThreadPool::~ThreadPool() {
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Stop = true;
+		}
+
+		m_Condition.notify_all();
+		for (std::thread& worker : m_Workers)
+			worker.join();
+	}
+
+	std::size_t ThreadPool::GetThreadCount() const {
+
+		return m_Workers.size() + 1;
+	}
+
+	std::size_t ThreadPool::GetQueueIndex() const {
+
+		return t_Pool == this ? t_QueueIndex : m_Queues.size() - 1;
+	}
+
+	void ThreadPool::Push(Task&& task) {
+
+		Queue& queue = *m_Queues[GetQueueIndex()];
+		{
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			queue.Tasks.push_back(std::move(task));
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Queued++;
+		}
+
+		m_Condition.notify_one();
+	}
+
+	bool ThreadPool::RunOne(std::size_t index) {
+
+		Task task;
+		bool found = false;
+
+		// The most recent task of the own queue
+		{
+			Queue& queue = *m_Queues[index];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			if (!queue.Tasks.empty()) {
+
+				task = std::move(queue.Tasks.back());
+				queue.Tasks.pop_back();
+				found = true;
+			}
+		}
+
+		// Otherwise, steal the oldest task of another queue
+		for (std::size_t i = 1; !found && i < m_Queues.size(); i++) {
+
+			Queue& queue = *m_Queues[(index + i) % m_Queues.size()];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			if (!queue.Tasks.empty()) {
+
+				task = std::move(queue.Tasks.front());
+				queue.Tasks.pop_front();
+				found = true;
+			}
+		}
+
+		if (!found)
+			return false;
+
+		m_Queued--;
+
+		try {
+
+			task.Function();
+		}
+
+		catch (...) {
+
+			std::lock_guard<std::mutex> lock(task.Group->m_Mutex);
+			if (!task.Group->m_Exception)
+				task.Group->m_Exception = std::current_exception();
+		}
+
+		task.Group->m_Pending--;
+
+		return true;
+	}
+
+	void ThreadPool::WorkerLoop(std::size_t index) {
+
+		t_Pool = this;
+		t_QueueIndex = index;
+
+		while (true) {
+
+			if (RunOne(index))
+				continue;
+
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Condition.wait(lock, [this]() { return m_Stop || m_Queued.load() != 0; });
+			if (m_Stop)
+				return;
+		}
+	}
+}
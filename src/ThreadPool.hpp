@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Utils {
+
+	/// <summary>
+	/// A work-stealing thread pool. Every worker owns a task queue: it pushes and pops its own tasks at the back, while the idle workers steal
+	/// them from the front. The threads that wait for a task group keep executing queued tasks, so nested task groups cannot deadlock
+	/// </summary>
+	class ThreadPool {
+
+	public:
+
+		/// <summary>
+		/// A group of tasks that can be waited for
+		/// </summary>
+		class TaskGroup {
+
+		public:
+
+			TaskGroup(ThreadPool& pool);
+
+			/// <summary>
+			/// Waits for the pending tasks (their exceptions are discarded)
+			/// </summary>
+			~TaskGroup();
+
+			TaskGroup(const TaskGroup&) = delete;
+			TaskGroup& operator=(const TaskGroup&) = delete;
+
+			/// <summary>
+			/// Queues a task in the pool
+			/// </summary>
+			/// <param name="task">The task</param>
+			void Run(std::function<void()> task);
+
+			/// <summary>
+			/// Waits for all the queued tasks, executing pool tasks in the meantime. If a task threw an exception, it is rethrown here
+			/// </summary>
+			void Wait();
+
+		private:
+
+			friend class ThreadPool;
+
+			ThreadPool& m_Pool;
+			std::atomic<std::size_t> m_Pending;
+			std::exception_ptr m_Exception;
+			std::mutex m_Mutex;
+		};
+
+		/// <summary>
+		/// Creates the pool
+		/// </summary>
+		/// <param name="threads">The number of threads that execute the tasks, including the one that waits for them (at least 1)</param>
+		ThreadPool(std::size_t threads);
+
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/// <returns>The number of threads that execute the tasks, including the one that waits for them</returns>
+		std::size_t GetThreadCount() const;
+
+	private:
+
+		struct Task {
+
+			std::function<void()> Function;
+			TaskGroup* Group;
+		};
+
+		struct Queue {
+
+			std::mutex Mutex;
+			std::deque<Task> Tasks;
+		};
+
+		/// <returns>The queue owned by the calling thread (threads outside the pool share the last one)</returns>
+		std::size_t GetQueueIndex() const;
+
+		void Push(Task&& task);
+
+		/// <summary>
+		/// Executes one queued task, preferring the most recent one of the given queue and stealing the oldest one of the others
+		/// </summary>
+		/// <param name="index">The queue of the calling thread</param>
+		/// <returns>True if a task was executed</returns>
+		bool RunOne(std::size_t index);
+
+		void WorkerLoop(std::size_t index);
+
+		std::vector<std::unique_ptr<Queue>> m_Queues;
+		std::vector<std::thread> m_Workers;
+		std::atomic<std::size_t> m_Queued;
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		bool m_Stop;
+	};
+}
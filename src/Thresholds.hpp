@@ -0,0 +1,40 @@
+#pragma once
+
+// The multiplication and division thresholds in limbs. This file can be regenerated with the tune program, which measures them on the host machine
+// (every value can be overridden at compile time, and SIZE_MAX marks an algorithm that never won in the measured range)
+
+#ifndef BI_KARATSUBA_THRESHOLD
+	#define BI_KARATSUBA_THRESHOLD 20
+#endif
+
+#ifndef BI_TOOM_COOK_3_THRESHOLD
+	#define BI_TOOM_COOK_3_THRESHOLD 57
+#endif
+
+#ifndef BI_TOOM_COOK_4_THRESHOLD
+	#define BI_TOOM_COOK_4_THRESHOLD 912
+#endif
+
+#ifndef BI_TOOM_COOK_6_THRESHOLD
+	#define BI_TOOM_COOK_6_THRESHOLD 1154
+#endif
+
+#ifndef BI_TOOM_COOK_8_THRESHOLD
+	#define BI_TOOM_COOK_8_THRESHOLD 5323
+#endif
+
+#ifndef BI_SSA_THRESHOLD
+	#define BI_SSA_THRESHOLD 6096
+#endif
+
+#ifndef BI_NTT_THRESHOLD
+	#define BI_NTT_THRESHOLD SIZE_MAX
+#endif
+
+#ifndef BI_BURNIKEL_ZIEGLER_THRESHOLD
+	#define BI_BURNIKEL_ZIEGLER_THRESHOLD 30
+#endif
+
+#ifndef BI_NEWTON_THRESHOLD
+	#define BI_NEWTON_THRESHOLD 6646
+#endif
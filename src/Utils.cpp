@@ -1,7 +1,28 @@
+#include <cassert>
 #include <cmath>
-#include <functional>
+#include <algorithm>
+#include <atomic>
+#include <vector>
 
 #include "Utils.hpp"
+#include "ThreadPool.hpp"
+
+// The x86-64 carry-chain intrinsics and the BMI2/ADX, SSE4.1 and AVX2 kernels (selected at runtime)
+#if (defined(_M_X64) || defined(__x86_64__)) && !defined(__ILP32__)
+	#define BI_X64_KERNELS
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+
+		// MSVC compiles the intrinsics of any instruction set without flags
+		#define BI_TARGET(features)
+	#else
+		#include <x86intrin.h>
+		#include <cpuid.h>
+
+		// Lets a kernel use instructions that are not enabled for the whole library
+		#define BI_TARGET(features) __attribute__((target(features)))
+	#endif
+#endif
 
 namespace Utils {
 
@@ -174,6 +195,423 @@ namespace Utils {
 		return 1;
 	}
 
+	// --- Word kernels ---
+
+	/// <summary>
+	/// Adds two words and an incoming carry
+	/// </summary>
+	/// <param name="carry">The incoming carry (0 or 1)</param>
+	/// <param name="a">The first word</param>
+	/// <param name="b">The second word</param>
+	/// <param name="r">The sum</param>
+	/// <returns>The outgoing carry</returns>
+	static inline unsigned char AddCarry(unsigned char carry, WORD a, WORD b, WORD& r) {
+
+#if defined(BI_X64_KERNELS)
+		unsigned long long sum;
+		carry = _addcarry_u64(carry, a, b, &sum);
+		r = (WORD)sum;
+
+		return carry;
+#else
+		const WORD sum = a + carry;
+		carry = sum < carry;
+		r = sum + b;
+
+		return carry | (r < sum);
+#endif
+	}
+
+	/// <summary>
+	/// Subtracts two words and an incoming borrow
+	/// </summary>
+	/// <param name="borrow">The incoming borrow (0 or 1)</param>
+	/// <param name="a">The minuend</param>
+	/// <param name="b">The subtrahend</param>
+	/// <param name="r">The difference</param>
+	/// <returns>The outgoing borrow</returns>
+	static inline unsigned char SubBorrow(unsigned char borrow, WORD a, WORD b, WORD& r) {
+
+#if defined(BI_X64_KERNELS)
+		unsigned long long diff;
+		borrow = _subborrow_u64(borrow, a, b, &diff);
+		r = (WORD)diff;
+
+		return borrow;
+#else
+		const WORD diff = a - b;
+		const unsigned char underflow = diff > a;
+		r = diff - borrow;
+
+		return underflow | (r > diff);
+#endif
+	}
+
+	/// <summary>
+	/// Multiply two word sized numbers and store the result in a dobule word sized number. Sign is not taken into consideration
+	/// </summary>
+	/// <param name="a">The first word</param>
+	/// <param name="b">The second word</param>
+	/// <param name="low">The low part of the double word</param>
+	/// <param name="high">The high part of the double word</param>
+	static inline void MultUWORD(WORD a, WORD b, WORD& low, WORD& high) {
+
+#if defined(__SIZEOF_INT128__)
+		const unsigned __int128 product = (unsigned __int128)a * b;
+		low = (WORD)product;
+		high = (WORD)(product >> 64);
+#elif defined(_M_X64)
+		unsigned long long h;
+		low = (WORD)_umul128(a, b, &h);
+		high = (WORD)h;
+#else
+		/*
+
+			Applied formula:
+
+			exp = (64 or 32)
+
+			(a_high � 2^(exp/2) + a_low) � (b_high � 2^(exp/2) + b_low)
+			= a_high�b_high�2^exp + (a_high�b_low + a_low�b_high)�2^(exp/2) + a_low�b_low
+
+		*/
+
+		constexpr HALFWORD HALF_WORD_BITS = sizeof(WORD) * 4;
+
+		// Split
+		WORD aLow = a & BI_MAX_HALFWORD; //0xFFFFFFFFULL
+		WORD aHigh = a >> HALF_WORD_BITS;
+		WORD bLow = b & BI_MAX_HALFWORD;
+		WORD bHigh = b >> HALF_WORD_BITS;
+
+		WORD ll = aLow * bLow;
+		WORD lh = aLow * bHigh;
+		WORD hl = aHigh * bLow;
+		WORD hh = aHigh * bHigh;
+
+		WORD middle1 = (ll >> HALF_WORD_BITS) + (lh & BI_MAX_HALFWORD) + (hl & BI_MAX_HALFWORD);
+		WORD middle2 = (lh >> HALF_WORD_BITS) + (hl >> HALF_WORD_BITS) + (middle1 >> HALF_WORD_BITS);
+
+		low = (ll & BI_MAX_HALFWORD) | (middle1 << HALF_WORD_BITS);
+		high = hh + middle2;
+#endif
+	}
+
+	/// <summary>
+	/// Divides a double word by a word, with the native 128/64 division where the platform has one
+	/// </summary>
+	/// <param name="high">The high part of the dividend (it must be less than the divisor)</param>
+	/// <param name="low">The low part of the dividend</param>
+	/// <param name="d">The divisor</param>
+	/// <param name="r">The remainder</param>
+	/// <returns>The quotient</returns>
+	static inline WORD DivideDoubleWord(WORD high, WORD low, WORD d, WORD& r) {
+
+#if defined(BI_X64_KERNELS) && !defined(_MSC_VER)
+		WORD q;
+		__asm__ ("divq %[d]" : "=a" (q), "=d" (r) : [d] "rm" (d), "a" (low), "d" (high) : "cc");
+
+		return q;
+#elif defined(BI_X64_KERNELS) && _MSC_VER >= 1920
+		unsigned long long rem;
+		const WORD q = (WORD)_udiv128(high, low, d, &rem);
+		r = (WORD)rem;
+
+		return q;
+#else
+		// Long division in base 2^(exp/2) of the normalized operands (Hacker's Delight, divlu)
+		constexpr unsigned int BITS_PER_WORD = sizeof(WORD) * 8;
+		constexpr unsigned int HALF_WORD_BITS = BITS_PER_WORD / 2;
+		constexpr WORD HALF_BASE = (WORD)1 << HALF_WORD_BITS;
+
+		unsigned int shift = 0;
+		while (!(d & ((WORD)1 << (BITS_PER_WORD - 1)))) {
+
+			d <<= 1;
+			shift++;
+		}
+
+		const WORD dHigh = d >> HALF_WORD_BITS;
+		const WORD dLow = d & BI_MAX_HALFWORD;
+		const WORD u32 = shift ? (high << shift) | (low >> (BITS_PER_WORD - shift)) : high;
+		const WORD u10 = low << shift;
+		const WORD u1 = u10 >> HALF_WORD_BITS;
+		const WORD u0 = u10 & BI_MAX_HALFWORD;
+
+		WORD q1 = u32 / dHigh;
+		WORD rhat = u32 - q1 * dHigh;
+		while (q1 >= HALF_BASE || q1 * dLow > ((rhat << HALF_WORD_BITS) | u1)) {
+
+			q1--;
+			rhat += dHigh;
+			if (rhat >= HALF_BASE)
+				break;
+		}
+
+		const WORD u21 = (u32 << HALF_WORD_BITS) + u1 - q1 * d;
+
+		WORD q0 = u21 / dHigh;
+		rhat = u21 - q0 * dHigh;
+		while (q0 >= HALF_BASE || q0 * dLow > ((rhat << HALF_WORD_BITS) | u0)) {
+
+			q0--;
+			rhat += dHigh;
+			if (rhat >= HALF_BASE)
+				break;
+		}
+
+		r = ((u21 << HALF_WORD_BITS) + u0 - q0 * d) >> shift;
+
+		return (q1 << HALF_WORD_BITS) | q0;
+#endif
+	}
+
+	/// <summary>
+	/// Computes the reciprocal of a normalized word, floor((B^2 - 1) / d) - B, where B is the word base
+	/// </summary>
+	/// <param name="d">The word (its most significant bit must be set)</param>
+	/// <returns>The reciprocal</returns>
+	static inline WORD ReciprocalWord(WORD d) {
+
+		WORD r;
+
+		return DivideDoubleWord(~d, BI_MAX_WORD, d, r);
+	}
+
+	/// <summary>
+	/// Divides a double word by a normalized word with its precomputed reciprocal, using two multiplications instead of a division
+	/// (Moller and Granlund, "Improved division by invariant integers")
+	/// </summary>
+	/// <param name="high">The high part of the dividend (it must be less than the divisor)</param>
+	/// <param name="low">The low part of the dividend</param>
+	/// <param name="d">The divisor (its most significant bit must be set)</param>
+	/// <param name="v">The divisor's reciprocal (see ReciprocalWord)</param>
+	/// <param name="r">The remainder</param>
+	/// <returns>The quotient</returns>
+	static inline WORD DivideDoubleWordPreinv(WORD high, WORD low, WORD d, WORD v, WORD& r) {
+
+		// (q1, q0) = v * high + (high, low)
+		WORD q0, q1;
+		MultUWORD(v, high, q0, q1);
+		const unsigned char carry = AddCarry(0, q0, low, q0);
+		AddCarry(carry, q1, high, q1);
+
+		// The candidate quotient is q1 + 1, which is off by at most one in each direction
+		q1++;
+		r = low - q1 * d;
+		if (r > q0) {
+
+			q1--;
+			r += d;
+		}
+
+		if (r >= d) {
+
+			q1++;
+			r -= d;
+		}
+
+		return q1;
+	}
+
+#if defined(BI_X64_KERNELS)
+
+	/// <returns>True if the processor supports the BMI2 (mulx) and ADX (adcx, adox) instructions</returns>
+	static bool HasBMI2AndADX() {
+
+		constexpr unsigned int BMI2_BIT = 1u << 8;
+		constexpr unsigned int ADX_BIT = 1u << 19;
+
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+
+		__cpuidex(info, 7, 0);
+		const unsigned int ebx = (unsigned int)info[1];
+#else
+		unsigned int eax, ebx, ecx, edx;
+		if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+			return false;
+#endif
+
+		return (ebx & BMI2_BIT) && (ebx & ADX_BIT);
+	}
+
+	/// <returns>True if the processor supports the SSSE3 and SSE4.1 instructions</returns>
+	static bool HasSSE41() {
+
+		constexpr unsigned int SSSE3_BIT = 1u << 9;
+		constexpr unsigned int SSE41_BIT = 1u << 19;
+
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 1);
+		const unsigned int ecx = (unsigned int)info[2];
+#else
+		unsigned int eax, ebx, ecx, edx;
+		if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+			return false;
+#endif
+
+		return (ecx & SSSE3_BIT) && (ecx & SSE41_BIT);
+	}
+
+	/// <returns>True if the processor supports the AVX2 instructions and the operating system saves their registers</returns>
+	static bool HasAVX2() {
+
+		constexpr unsigned int OSXSAVE_BIT = 1u << 27;
+		constexpr unsigned int AVX_BIT = 1u << 28;
+		constexpr unsigned int AVX2_BIT = 1u << 5;
+
+		// The XMM and YMM state bits of the extended control register
+		constexpr unsigned int YMM_STATE = 6;
+
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+
+		__cpuid(info, 1);
+		const unsigned int ecx = (unsigned int)info[2];
+		if (!(ecx & OSXSAVE_BIT) || !(ecx & AVX_BIT) || (_xgetbv(0) & YMM_STATE) != YMM_STATE)
+			return false;
+
+		__cpuidex(info, 7, 0);
+		const unsigned int ebx = (unsigned int)info[1];
+#else
+		unsigned int eax, ebx, ecx, edx;
+		if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & OSXSAVE_BIT) || !(ecx & AVX_BIT))
+			return false;
+
+		unsigned int xcr0, xcr0High;
+		__asm__ ("xgetbv" : "=a" (xcr0), "=d" (xcr0High) : "c" (0));
+		if ((xcr0 & YMM_STATE) != YMM_STATE)
+			return false;
+
+		if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+			return false;
+#endif
+
+		return (ebx & AVX2_BIT) != 0;
+	}
+
+	// Checked once at startup (before that, the portable kernels are used)
+	static const bool s_HasBMI2AndADX = HasBMI2AndADX();
+	static const bool s_HasSSE41 = HasSSE41();
+	static const bool s_HasAVX2 = HasAVX2();
+
+	/// <summary>
+	/// Multiplies a word array by a word and adds the result to another word array (r += a * c) with mulx. The high half of every product
+	/// and the destination words are added on two independent carry chains (adcx on the carry flag, adox on the overflow flag)
+	/// </summary>
+	/// <param name="r">The word array where the result will be accumulated</param>
+	/// <param name="a">The word array to multiply</param>
+	/// <param name="n">The arrays' length (at least 1)</param>
+	/// <param name="c">The word</param>
+	/// <returns>The carry out of the most significant word</returns>
+#if defined(_MSC_VER)
+	static WORD AddMultWordADX(WORD* r, const WORD* a, std::size_t n, WORD c) {
+
+		unsigned long long high = 0;
+		unsigned char cf = 0;
+		unsigned char of = 0;
+		for (std::size_t i = 0; i < n; i++) {
+
+			unsigned long long h;
+			unsigned long long low = _mulx_u64(a[i], c, &h);
+			cf = _addcarryx_u64(cf, low, high, &low);
+			of = _addcarryx_u64(of, low, r[i], &low);
+			r[i] = (WORD)low;
+			high = h;
+		}
+
+		_addcarryx_u64(cf, high, 0, &high);
+		_addcarryx_u64(of, high, 0, &high);
+
+		return (WORD)high;
+	}
+#else
+	static WORD AddMultWordADX(WORD* r, const WORD* a, std::size_t n, WORD c) {
+
+		// The words that do not fill a group of four go through the portable loop, whose carry enters the carry chain
+		WORD high = 0;
+		const std::size_t head = n % 4;
+		for (std::size_t i = 0; i < head; i++) {
+
+			WORD low, h;
+			MultUWORD(a[i], c, low, h);
+
+			low += high;
+			h += low < high;
+			r[i] += low;
+			h += r[i] < low;
+			high = h;
+		}
+
+		if (head == n)
+			return high;
+
+		// The index runs from -n up to 0, so that the loop control (lea, jrcxz) leaves the flags untouched
+		std::ptrdiff_t i = -(std::ptrdiff_t)(n - head);
+		WORD low, h;
+
+		__asm__ (
+			"xorl %k[low], %k[low]\n\t"
+			"1:\n\t"
+			"mulxq (%[a], %[i], 8), %[low], %[h]\n\t"
+			"adcxq %[high], %[low]\n\t"
+			"adoxq (%[r], %[i], 8), %[low]\n\t"
+			"movq %[low], (%[r], %[i], 8)\n\t"
+			"mulxq 8(%[a], %[i], 8), %[low], %[high]\n\t"
+			"adcxq %[h], %[low]\n\t"
+			"adoxq 8(%[r], %[i], 8), %[low]\n\t"
+			"movq %[low], 8(%[r], %[i], 8)\n\t"
+			"mulxq 16(%[a], %[i], 8), %[low], %[h]\n\t"
+			"adcxq %[high], %[low]\n\t"
+			"adoxq 16(%[r], %[i], 8), %[low]\n\t"
+			"movq %[low], 16(%[r], %[i], 8)\n\t"
+			"mulxq 24(%[a], %[i], 8), %[low], %[high]\n\t"
+			"adcxq %[h], %[low]\n\t"
+			"adoxq 24(%[r], %[i], 8), %[low]\n\t"
+			"movq %[low], 24(%[r], %[i], 8)\n\t"
+			"leaq 4(%[i]), %[i]\n\t"
+			"jrcxz 2f\n\t"
+			"jmp 1b\n\t"
+			"2:\n\t"
+			"movl $0, %k[low]\n\t"
+			"adcxq %[low], %[high]\n\t"
+			"adoxq %[low], %[high]\n\t"
+			: [i] "+c" (i), [high] "+&r" (high), [low] "=&r" (low), [h] "=&r" (h)
+			: [a] "r" (a + n), [r] "r" (r + n), "d" (c)
+			: "cc", "memory"
+		);
+
+		return high;
+	}
+#endif
+
+#endif
+
+	// Cleared to run the portable multiply-accumulate kernel on processors that support the BMI2/ADX one
+	static std::atomic<bool> s_UseBMI2AndADX(true);
+
+	void SetADXKernel(bool enabled) {
+
+		s_UseBMI2AndADX.store(enabled, std::memory_order_relaxed);
+	}
+
+	bool GetADXKernel() {
+
+#if defined(BI_X64_KERNELS)
+		return s_HasBMI2AndADX && s_UseBMI2AndADX.load(std::memory_order_relaxed);
+#else
+		return false;
+#endif
+	}
+
 	// --- Mathematical functions ---
 
 	int Compare(const BigInt_T& a, const BigInt_T& b) {
@@ -398,14 +836,14 @@ namespace Utils {
 		if (a.Size < size)
 			Resize(a, size);
 
-		WORD carry = 0;
-		for (std::size_t i = 0; i < size; i++) {
+		const std::size_t common = std::min(size, b.Size);
+		unsigned char carry = 0;
+		std::size_t i = 0;
+		for (; i < common; i++)
+			carry = AddCarry(carry, a.Buffer[i], b.Buffer[i], a.Buffer[i]);
 
-			const WORD sum = a.Buffer[i] + (i < b.Size ? b.Buffer[i] : 0);
-			const bool overflow = sum < a.Buffer[i];
-			a.Buffer[i] = sum + carry;
-			carry = (overflow || a.Buffer[i] < sum) ? 1 : 0;
-		}
+		for (; i < size && carry; i++)
+			carry = AddCarry(carry, a.Buffer[i], 0, a.Buffer[i]);
 
 		if (carry != 0) {
 
@@ -456,759 +894,4225 @@ namespace Utils {
 
 		// @TODO: ASSERT THAT a.Size > b.Size and Compare(a, b) > 1 || Compare(a, b) == 0
 
-		WORD borrow = 0;
-		for (std::size_t i = 0; i < a.Size; i++) {
-
-			const WORD& ai = a.Buffer[i];
-			const WORD& bi = i < b.Size ? b.Buffer[i] : 0;
+		const std::size_t common = std::min(a.Size, b.Size);
+		unsigned char borrow = 0;
+		std::size_t i = 0;
+		for (; i < common; i++)
+			borrow = SubBorrow(borrow, a.Buffer[i], b.Buffer[i], a.Buffer[i]);
 
-			WORD temp = ai - bi - borrow;
-			borrow = (ai < bi + borrow) || (bi + borrow < bi);
-			a.Buffer[i] = temp;
-		}
+		for (; i < a.Size && borrow; i++)
+			borrow = SubBorrow(borrow, a.Buffer[i], 0, a.Buffer[i]);
 	}
 
 	/// <summary>
-	/// Multiply two word sized numbers and store the result in a dobule word sized number. Sign is not taken into consideration
+	/// Adds two word arrays of the same length
 	/// </summary>
-	/// <param name="a">The first word</param>
-	/// <param name="b">The second word</param>
-	/// <param name="low">The low part of the double word</param>
-	/// <param name="high">The high part of the double word</param>
-	static void MultUWORD(WORD a, WORD b, WORD& low, WORD& high) {
-
-		/*
+	/// <param name="r">The result array (it can be one of the addends)</param>
+	/// <param name="a">The first addend</param>
+	/// <param name="b">The second addend</param>
+	/// <param name="n">The arrays' length</param>
+	/// <returns>The carry out of the most significant word</returns>
+	static WORD AddWords(WORD* r, const WORD* a, const WORD* b, std::size_t n) {
+
+		unsigned char carry = 0;
+		for (std::size_t i = 0; i < n; i++)
+			carry = AddCarry(carry, a[i], b[i], r[i]);
+
+		return carry;
+	}
 
-			Applied formula:
+	/// <summary>
+	/// Subtracts two word arrays of the same length
+	/// </summary>
+	/// <param name="r">The result array (it can be the minuend or the subtrahend)</param>
+	/// <param name="a">The minuend</param>
+	/// <param name="b">The subtrahend</param>
+	/// <param name="n">The arrays' length</param>
+	/// <returns>The borrow out of the most significant word</returns>
+	static WORD SubWords(WORD* r, const WORD* a, const WORD* b, std::size_t n) {
+
+		unsigned char borrow = 0;
+		for (std::size_t i = 0; i < n; i++)
+			borrow = SubBorrow(borrow, a[i], b[i], r[i]);
+
+		return borrow;
+	}
 
-			exp = (64 or 32)
+	/// <summary>
+	/// Adds a single word to a word array, propagating the carry
+	/// </summary>
+	/// <param name="r">The word array (also the result)</param>
+	/// <param name="n">The array's length</param>
+	/// <param name="c">The word to add</param>
+	/// <returns>The carry out of the most significant word</returns>
+	static WORD AddWord(WORD* r, std::size_t n, WORD c) {
 
-			(a_high  2^(exp/2) + a_low)  (b_high  2^(exp/2) + b_low)
-			= a_highb_high2^exp + (a_highb_low + a_lowb_high)2^(exp/2) + a_lowb_low
+		for (std::size_t i = 0; i < n && c; i++) {
 
-		*/
+			r[i] += c;
+			c = r[i] < c;
+		}
 
-		constexpr HALFWORD HALF_WORD_BITS = sizeof(WORD) * 4;
+		return c;
+	}
 
-		// Split
-		WORD aLow = a & BI_MAX_HALFWORD; //0xFFFFFFFFULL
-		WORD aHigh = a >> HALF_WORD_BITS;
-		WORD bLow = b & BI_MAX_HALFWORD;
-		WORD bHigh = b >> HALF_WORD_BITS;
+	/// <summary>
+	/// Subtracts a single word from a word array, propagating the borrow
+	/// </summary>
+	/// <param name="r">The word array (also the result)</param>
+	/// <param name="n">The array's length</param>
+	/// <param name="c">The word to subtract</param>
+	/// <returns>The borrow out of the most significant word</returns>
+	static WORD SubWord(WORD* r, std::size_t n, WORD c) {
 
-		WORD ll = aLow * bLow;
-		WORD lh = aLow * bHigh;
-		WORD hl = aHigh * bLow;
-		WORD hh = aHigh * bHigh;
+		for (std::size_t i = 0; i < n && c; i++) {
 
-		WORD middle1 = (ll >> HALF_WORD_BITS) + (lh & BI_MAX_HALFWORD) + (hl & BI_MAX_HALFWORD);
-		WORD middle2 = (lh >> HALF_WORD_BITS) + (hl >> HALF_WORD_BITS) + (middle1 >> HALF_WORD_BITS);
+			const WORD v = r[i];
+			r[i] = v - c;
+			c = r[i] > v;
+		}
 
-		low = (ll & BI_MAX_HALFWORD) | (middle1 << HALF_WORD_BITS);
-		high = hh + middle2;
+		return c;
 	}
 
 	/// <summary>
-	/// Multiply a big integer by one word
+	/// Shifts a word array to the left by less than a word
 	/// </summary>
-	/// <param name="a">The big integer (also the final result of the operation)</param>
-	/// <param name="c">The word</param>
-	static void MultiplyByWord(BigInt_T& a, WORD c) {
-
-		WORD carry = 0;
-		for (std::size_t i = 0; i < a.Size; i++) {
+	/// <param name="r">The result array (it can be the source array)</param>
+	/// <param name="a">The source array</param>
+	/// <param name="n">The arrays' length</param>
+	/// <param name="bits">The shift amount (between 1 and the word bit size minus one)</param>
+	/// <returns>The bits shifted out of the most significant word</returns>
+	static WORD ShiftLeftWords(WORD* r, const WORD* a, std::size_t n, unsigned int bits) {
 
-			WORD low, high;
-			MultUWORD(a.Buffer[i], c, low, high);
+		constexpr unsigned int BITS_PER_WORD = sizeof(WORD) * 8;
 
-			WORD temp = low + carry;
-			if (temp < low)
-				++high;
+		WORD out = 0;
+		for (std::size_t i = 0; i < n; i++) {
 
-			a.Buffer[i] = temp;
-			carry = high;
+			const WORD v = a[i];
+			r[i] = (v << bits) | out;
+			out = v >> (BITS_PER_WORD - bits);
 		}
-	}
 
-	void Mult(BigInt_T& first, const BigInt_T& second) {
+		return out;
+	}
 
-		std::size_t firstSize = CountSignificantWords(first);
-		std::size_t secondSize = CountSignificantWords(second);
+	// --- Schonhage-Strassen multiplication ---
 
-		if (firstSize == 1 && secondSize == 1) {
+	// The lowest allowed threshold (below it, the pointwise products would not be smaller than the factors)
+	constexpr std::size_t SSA_MIN_THRESHOLD = 64;
 
-			// If the number is less than BI_MAX_HALFWORD, we can simply multiply the two buffers
-			if (*first.Buffer <= BI_MAX_HALFWORD &&
-				*second.Buffer <= BI_MAX_HALFWORD)
+	// The limb size from which the multiplication switches to the Schonhage-Strassen algorithm
+	static std::atomic<std::size_t> s_SSAThreshold(BI_SSA_THRESHOLD < SSA_MIN_THRESHOLD ? SSA_MIN_THRESHOLD : BI_SSA_THRESHOLD);
 
-			{
+	void SetSSAThreshold(std::size_t limbs) {
 
-				*first.Buffer *= *second.Buffer;
+		s_SSAThreshold.store(std::max(limbs, SSA_MIN_THRESHOLD), std::memory_order_relaxed);
+	}
 
-				return;
-			}
-		}
+	std::size_t GetSSAThreshold() {
 
-		// Basecase multiplication
-		static std::function<void(BigInt_T&, const BigInt_T&)> Basecase
-		=
-		[](BigInt_T& a, const BigInt_T& b) {
+		return s_SSAThreshold.load(std::memory_order_relaxed);
+	}
 
-			const std::size_t aSize = CountSignificantWords(a);
-			const std::size_t bSize = CountSignificantWords(b);
+	/*
 
-			if (aSize == 1 && bSize == 1) {
+		Every residue modulo 2^N + 1 (with N = n * word bit size) is stored in n + 1 words and its value
+		is always kept between 0 and 2^N (inclusive), so the most significant word is either zero or one
 
-				// If the number is less than 4294967295, we can simply multiply the two buffers
-				if (*a.Buffer <= BI_MAX_HALFWORD &&
-					*b.Buffer <= BI_MAX_HALFWORD)
+	*/
 
-				{
+	/// <summary>
+	/// Reduces a residue whose most significant word has overflowed (value lower than 2^(N + word bit size))
+	/// </summary>
+	/// <param name="x">The residue (n + 1 words)</param>
+	/// <param name="n">The residue size in words (without the extra word)</param>
+	static void FermatNormalize(WORD* x, std::size_t n) {
+
+		// x = low + high * 2^N = low - high (mod 2^N + 1)
+		const WORD high = x[n];
+		x[n] = 0;
+		if (SubWord(x, n, high))
+			AddWord(x, n + 1, 1);
+	}
 
-					*a.Buffer *= *b.Buffer;
-				}
+	/// <summary>
+	/// Negates a residue modulo 2^N + 1
+	/// </summary>
+	/// <param name="x">The residue (n + 1 words)</param>
+	/// <param name="n">The residue size in words (without the extra word)</param>
+	static void FermatNegate(WORD* x, std::size_t n) {
 
-				else {
+		bool zero = true;
+		for (std::size_t i = 0; i <= n && zero; i++)
+			zero = x[i] == 0;
 
-					MultUWORD(a.Buffer[0], b.Buffer[0], a.Buffer[0], a.Buffer[1]);
-				}
+		if (zero)
+			return;
 
-				return;
-			}
+		// x = 2^N + 1 - x = ~x + 1 + 2^N + 1 (mod 2^((n + 1) * word bit size))
+		for (std::size_t i = 0; i <= n; i++)
+			x[i] = ~x[i];
+		AddWord(x, n + 1, 2);
+		x[n] += 1;
+	}
 
-			BigInt_T c;
-			Resize(c, aSize);
-			Copy(c, a);
-			MultiplyByWord(a, b.Buffer[0]);
-			for (std::size_t j = 1; j < bSize; j++) {
+	/// <summary>
+	/// Adds two residues modulo 2^N + 1
+	/// </summary>
+	static void FermatAdd(WORD* r, const WORD* a, const WORD* b, std::size_t n) {
 
-				BigInt_T d;
-				Resize(d, aSize + 1 + j);
-				Copy(d, c);
-				MultiplyByWord(d, b.Buffer[j]);
-				ShiftLeft(d, j * sizeof(WORD) * 8);
-				AddU(a, d);
-			}
-		};
+		AddWords(r, a, b, n + 1);
+		FermatNormalize(r, n);
+	}
 
-		// Karatsuba algorithm
-		static std::function<void(BigInt_T&, const BigInt_T&)> Karatsuba
-		=
-		[](BigInt_T& a, const BigInt_T& b) {
+	/// <summary>
+	/// Subtracts two residues modulo 2^N + 1
+	/// </summary>
+	static void FermatSub(WORD* r, const WORD* a, const WORD* b, std::size_t n) {
 
-			std::size_t aSize = CountSignificantWords(a);
-			std::size_t bSize = CountSignificantWords(b);
+		// If the difference is negative, add 2^N + 1
+		if (SubWords(r, a, b, n + 1)) {
 
-			if (aSize < 1024 || bSize < 1024) {
+			AddWord(r, n + 1, 1);
+			r[n] += 1;
+		}
+	}
 
-				Basecase(a, b);
+	/// <summary>
+	/// Multiplies a residue by 2^s modulo 2^N + 1 (with s lower than 2N)
+	/// </summary>
+	/// <param name="r">The result (n + 1 words, it must not overlap the residue)</param>
+	/// <param name="a">The residue (n + 1 words)</param>
+	/// <param name="n">The residue size in words (without the extra word)</param>
+	/// <param name="s">The power of two exponent</param>
+	/// <param name="scratch">A scratch buffer of 2n + 2 words</param>
+	static void FermatMultBy2Exp(WORD* r, const WORD* a, std::size_t n, std::size_t s, WORD* scratch) {
+
+		constexpr std::size_t BITS_PER_WORD = sizeof(WORD) * 8;
+
+		// 2^N = -1 (mod 2^N + 1)
+		const bool negate = s >= n * BITS_PER_WORD;
+		if (negate)
+			s -= n * BITS_PER_WORD;
+
+		const std::size_t offset = s / BITS_PER_WORD;
+		const unsigned int bits = (unsigned int)(s % BITS_PER_WORD);
+
+		// scratch = a * 2^s (lower than 2^(2N))
+		memset(scratch, 0, (2 * n + 2) * sizeof(WORD));
+		if (bits == 0)
+			bi_memcpy(scratch + offset, (2 * n + 2 - offset) * sizeof(WORD), a, (n + 1) * sizeof(WORD));
+		else
+			scratch[offset + n + 1] = ShiftLeftWords(scratch + offset, a, n + 1, bits);
+
+		// low + high * 2^N = low - high (mod 2^N + 1)
+		bi_memcpy(r, (n + 1) * sizeof(WORD), scratch, n * sizeof(WORD));
+		r[n] = 0;
+		if (SubWords(r, r, scratch + n, n))
+			AddWord(r, n + 1, 1);
+
+		if (negate)
+			FermatNegate(r, n);
+	}
 
-				return;
-			}
+	/// <summary>
+	/// Multiplies two residues modulo 2^N + 1
+	/// </summary>
+	/// <param name="r">The result (n + 1 words, it can overlap the first residue)</param>
+	/// <param name="a">The first residue (n + 1 words)</param>
+	/// <param name="b">The second residue (n + 1 words)</param>
+	/// <param name="n">The residue size in words (without the extra word)</param>
+	static void FermatMult(WORD* r, const WORD* a, const WORD* b, std::size_t n) {
 
-			// Split
-
-			const std::size_t size = std::max(aSize, bSize);
-			const std::size_t sp = size / 2;
-
-			// A0
-			BigInt_T a0;
-			Resize(a0, sp);
-			for (std::size_t i = 0; i < sp; i++)
-				a0.Buffer[i] = i < aSize ? a.Buffer[i] : 0;
-
-			// A1
-			BigInt_T a1;
-			Resize(a1, sp + 2); // Plus 2 for the possible carry in the later sum
-			for (std::size_t i = sp; i < size; i++)
-				a1.Buffer[i - sp] = i < aSize ? a.Buffer[i] : 0;
-
-			// B0
-			BigInt_T b0;
-			Resize(b0, sp);
-			for (std::size_t i = 0; i < sp; i++)
-				b0.Buffer[i] = i < bSize ? b.Buffer[i] : 0;
-
-			// B1
-			BigInt_T b1;
-			Resize(b1, sp + 2); // Plus 2 for the possible carry in the later sum
-			for (std::size_t i = sp; i < size; i++)
-				b1.Buffer[i - sp] = i < bSize ? b.Buffer[i] : 0;
-
-			// K1
-			BigInt_T k1;
-			std::size_t a1Size = CountSignificantWords(a1);
-			Resize(k1, a1Size + CountSignificantWords(b1) + 2 * sp);
-			bi_memcpy(k1.Buffer, k1.Size * sizeof(WORD), a1.Buffer, a1Size * sizeof(WORD));
-			Karatsuba(k1, b1);
-
-			// K2
-			BigInt_T k2;
-			AddU(a1, a0);
-			AddU(b1, b0);
-			a1Size = CountSignificantWords(a1);
-			Resize(k2, a1Size + CountSignificantWords(b1) + sp);
-			bi_memcpy(k2.Buffer, k2.Size * sizeof(WORD), a1.Buffer, a1Size * sizeof(WORD));
-			Karatsuba(k2, b1);
-
-			// K3
-			BigInt_T k3;
-			std::size_t a0Size = CountSignificantWords(a0);
-			Resize(k3, a0Size + CountSignificantWords(b0));
-			bi_memcpy(k3.Buffer, k3.Size * sizeof(WORD), a0.Buffer, a0Size * sizeof(WORD));
-			Karatsuba(k3, b0);
-
-			SubU(k2, k3);
-			SubU(k2, k1);
-
-			ShiftLeft(k1, 16 * sp * sizeof(WORD));
-			ShiftLeft(k2, 8 * sp * sizeof(WORD));
-
-			memset(a.Buffer, 0, a.Size * sizeof(WORD));
-			AddU(a, k1);
-			AddU(a, k2);
-			AddU(a, k3);
-		};
+		// One of the two residues is 2^N = -1
+		if (a[n] || b[n]) {
 
-		// Toom-Cook 3-Way algorithm
-		static std::function<void(BigInt_T&, const BigInt_T&)> ToomCook3
-		=
-		[](BigInt_T& a, const BigInt_T& b) {
+			const WORD* other = a[n] ? b : a;
+			if (r != other)
+				bi_memcpy(r, (n + 1) * sizeof(WORD), other, (n + 1) * sizeof(WORD));
+			FermatNegate(r, n);
 
-			// Divide by 3
-			auto DivideBy3
-			=
-			[](BigInt_T& a) {
+			return;
+		}
 
-				constexpr WORD BASE = (WORD)1 << (sizeof(WORD) * 4);
+		BigInt_T x, y;
+		Resize(x, 2 * n);
+		Resize(y, n);
+		bi_memcpy(x.Buffer, x.Size * sizeof(WORD), a, n * sizeof(WORD));
+		bi_memcpy(y.Buffer, y.Size * sizeof(WORD), b, n * sizeof(WORD));
+		Mult(x, y);
+
+		// low + high * 2^N = low - high (mod 2^N + 1)
+		bi_memcpy(r, (n + 1) * sizeof(WORD), x.Buffer, n * sizeof(WORD));
+		r[n] = 0;
+		if (SubWords(r, r, x.Buffer + n, n))
+			AddWord(r, n + 1, 1);
+	}
 
-				HALFWORD* buffer = (HALFWORD*)a.Buffer;
-				const std::size_t n = a.Size * 2;
-				constexpr WORD d = 2'863'311'531; // Precomputed inverse module between 3 and 2^32
-				HALFWORD b = 0;
-				for (size_t i = 0; i < n; ++i) {
+	/// <summary>
+	/// Decimation-in-frequency transform (natural order input, bit-reversed order output) of K residues modulo 2^N + 1,
+	/// using 2^(2N/K) as the K-th root of unity
+	/// </summary>
+	/// <param name="data">The K residues (n + 1 words each)</param>
+	/// <param name="k">The base 2 logarithm of K</param>
+	/// <param name="n">The residue size in words (without the extra word)</param>
+	/// <param name="scratch">A scratch buffer of 3n + 3 words</param>
+	static void FermatForwardTransform(WORD* data, std::size_t k, std::size_t n, WORD* scratch) {
 
-					WORD ai = buffer[i];
-					WORD x, b1;
-					if (b <= ai) {
+		const std::size_t K = (std::size_t)1 << k;
+		const std::size_t rootExp = 2 * n * sizeof(WORD) * 8 / K;
+		WORD* diff = scratch + 2 * n + 2;
 
-						x = ai - b;
-						b1 = 0;
-					}
+		for (std::size_t len = K; len >= 2; len >>= 1) {
 
-					else {
+			const std::size_t half = len / 2;
+			const std::size_t stepExp = rootExp * (K / len);
+			for (std::size_t start = 0; start < K; start += len) {
 
-						x = ai + BASE - b;
-						b1 = 1;
-					}
+				for (std::size_t j = 0; j < half; j++) {
 
-					WORD q = (d * x) % BASE;
-					buffer[i] = (HALFWORD)q;
+					WORD* u = data + (start + j) * (n + 1);
+					WORD* v = data + (start + j + half) * (n + 1);
 
-					WORD prod = (WORD)q * 3;
-					WORD b2 = (prod - x) / BASE;
-					b = (HALFWORD)(b1 + (HALFWORD)b2);
+					FermatSub(diff, u, v, n);
+					FermatAdd(u, u, v, n);
+					FermatMultBy2Exp(v, diff, n, j * stepExp, scratch);
 				}
+			}
+		}
+	}
 
-				return b;
-			};
-
-			const std::size_t aSize = CountSignificantWords(a);
-			const std::size_t bSize = CountSignificantWords(b);
+	/// <summary>
+	/// Decimation-in-time inverse transform (bit-reversed order input, natural order output) of K residues modulo 2^N + 1.
+	/// The result is not scaled by 1/K
+	/// </summary>
+	/// <param name="data">The K residues (n + 1 words each)</param>
+	/// <param name="k">The base 2 logarithm of K</param>
+	/// <param name="n">The residue size in words (without the extra word)</param>
+	/// <param name="scratch">A scratch buffer of 3n + 3 words</param>
+	static void FermatInverseTransform(WORD* data, std::size_t k, std::size_t n, WORD* scratch) {
 
-			if (aSize < 15000 || bSize < 15000) {
+		const std::size_t K = (std::size_t)1 << k;
+		const std::size_t N2 = 2 * n * sizeof(WORD) * 8;
+		const std::size_t rootExp = N2 / K;
+		WORD* twiddled = scratch + 2 * n + 2;
 
-				// If the first factor is equal to zero, do not bother executing the algorithm
-				if (aSize == 1)
-					if (a.Buffer[0] == 0)
-						return;
+		for (std::size_t len = 2; len <= K; len <<= 1) {
 
-				// Same thing for the other factor
-				if (bSize == 1) {
+			const std::size_t half = len / 2;
+			const std::size_t stepExp = rootExp * (K / len);
+			for (std::size_t start = 0; start < K; start += len) {
 
-					if (b.Buffer[0] == 0) {
+				for (std::size_t j = 0; j < half; j++) {
 
-						memset(a.Buffer, 0, a.Size * sizeof(WORD));
+					WORD* u = data + (start + j) * (n + 1);
+					WORD* v = data + (start + j + half) * (n + 1);
 
-						return;
-					}
+					// The inverse root is 2^(2N - exp)
+					const std::size_t exp = j * stepExp;
+					FermatMultBy2Exp(twiddled, v, n, exp == 0 ? 0 : N2 - exp, scratch);
+					FermatSub(v, u, twiddled, n);
+					FermatAdd(u, u, twiddled, n);
 				}
+			}
+		}
+	}
 
-				Karatsuba(a, b);
+	/// <summary>
+	/// Multiplies two word arrays with the Schonhage-Strassen algorithm
+	/// </summary>
+	/// <param name="r">The product (na + nb words, it must not overlap the factors)</param>
+	/// <param name="a">The first factor</param>
+	/// <param name="na">The first factor size in words</param>
+	/// <param name="b">The second factor</param>
+	/// <param name="nb">The second factor size in words</param>
+	static void SchonhageStrassen(WORD* r, const WORD* a, std::size_t na, const WORD* b, std::size_t nb) {
 
-				return;
-			}
+		constexpr std::size_t BITS_PER_WORD = sizeof(WORD) * 8;
 
-			// Split
-
-			const std::size_t size = std::max(aSize, bSize);
-			const std::size_t k = (std::size_t)std::ceil((long double)size / 3.0);
-
-			BigInt_T a0, a1, a2, b0, b1, b2;
-			Resize(a0, k);
-			Resize(a1, k + 1);
-			Resize(a2, size - 2 * k + 1);
-			Resize(b0, k);
-			Resize(b1, k + 1);
-			Resize(b2, size - 2 * k + 1);
-
-			// A0
-			for (std::size_t i = 0; i < k; i++)
-				a0.Buffer[i] = i < aSize ? a.Buffer[i] : 0;
-
-			// A1
-			for (std::size_t i = k; i < 2 * k; i++)
-				a1.Buffer[i - k] = i < aSize ? a.Buffer[i] : 0;
-
-			// A2
-			for (std::size_t i = 2 * k; i < size; i++)
-				a2.Buffer[i - 2 * k] = i < aSize ? a.Buffer[i] : 0;
-
-			// B0
-			for (std::size_t i = 0; i < k; i++)
-				b0.Buffer[i] = i < bSize ? b.Buffer[i] : 0;
-
-			// B1
-			for (std::size_t i = k; i < 2 * k; i++)
-				b1.Buffer[i - k] = i < bSize ? b.Buffer[i] : 0;
-
-			// B2
-			for (std::size_t i = 2 * k; i < size; i++)
-				b2.Buffer[i - 2 * k] = i < bSize ? b.Buffer[i] : 0;
-
-			// A02
-			BigInt_T a02;
-			Resize(a02, std::max(CountSignificantWords(a0), CountSignificantWords(a2)) + 1);
-			Copy(a02, a0);
-			AddU(a02, a2);
-
-			// B02
-			BigInt_T b02;
-			Resize(b02, std::max(CountSignificantWords(b0), CountSignificantWords(b2)) + 1);
-			Copy(b02, b0);
-			AddU(b02, b2);
-
-			// A012
-			BigInt_T a012;
-			Resize(a012, std::max(CountSignificantWords(a02), CountSignificantWords(a1)) + 1);
-			Copy(a012, a02);
-			AddU(a012, a1);
-
-			// B012
-			BigInt_T b012;
-			Resize(b012, std::max(CountSignificantWords(b02), CountSignificantWords(b1)) + 1);
-			Copy(b012, b02);
-			AddU(b012, b1);
-
-			// V0
-			BigInt_T v0;
-			Resize(v0, CountSignificantWords(a0) + CountSignificantWords(b0));
-			Copy(v0, a0);
-			ToomCook3(v0, b0);
-
-			// V1
-			BigInt_T v1;
-			Resize(v1, CountSignificantWords(a012) + CountSignificantWords(b012));
-			Copy(v1, a012);
-			ToomCook3(v1, b012);
-
-			// Vm1
-			BigInt_T vm1;
-			Sub(a02, a1);
-			Sub(b02, b1);
-			Resize(vm1, CountSignificantWords(a02) + CountSignificantWords(b02) + 1);
-			Copy(vm1, a02);
-			ToomCook3(vm1, b02);
-			vm1.Sign = a02.Sign ^ b02.Sign;
-
-			// a1 -> 2*a1
-			ShiftLeft(a1, 1);
-
-			// a2 -> 4*a2
-			ShiftLeft(a2, 2);
-
-			// b1 -> 2*b1
-			ShiftLeft(b1, 1);
-
-			// b2 -> 4*b2
-			ShiftLeft(b2, 2);
-
-			// A0_2A1_4A2
-			BigInt_T a0_2a1_4a2;
-			Resize(a0_2a1_4a2, std::max(CountSignificantWords(a0), std::max(CountSignificantWords(a1), CountSignificantWords(a2))) + 1);
-			Copy(a0_2a1_4a2, a0);
-			AddU(a0_2a1_4a2, a1);
-			AddU(a0_2a1_4a2, a2);
-
-			// B0_2B1_4B2
-			BigInt_T b0_2b1_4b2;
-			Resize(b0_2b1_4b2, std::max(CountSignificantWords(b0), std::max(CountSignificantWords(b1), CountSignificantWords(b2))) + 1);
-			Copy(b0_2b1_4b2, b0);
-			AddU(b0_2b1_4b2, b1);
-			AddU(b0_2b1_4b2, b2);
-
-			// 4*a2 -> a2
-			ShiftRight(a2, 2);
-
-			// 4*b2 -> b2
-			ShiftRight(b2, 2);
-
-			// V2
-			BigInt_T v2;
-			Resize(v2, CountSignificantWords(a0_2a1_4a2) + CountSignificantWords(b0_2b1_4b2));
-			Copy(v2, a0_2a1_4a2);
-			ToomCook3(v2, b0_2b1_4b2);
-
-			// Vinf
-			BigInt_T vinf;
-			Resize(vinf, CountSignificantWords(a2) + CountSignificantWords(b2) + 1);
-			Copy(vinf, a2);
-			ToomCook3(vinf, b2);
-
-			// vm1 -> 2*vm1
-			ShiftLeft(vm1, 1);
-
-			// vinf -> 2*vinf
-			ShiftLeft(vinf, 1);
-
-			// 3*V0
-			BigInt_T _3v0;
-			Resize(_3v0, std::max(CountSignificantWords(v0) + 1, std::max(CountSignificantWords(vm1), CountSignificantWords(v2))) + 1);
-			Copy(_3v0, v0);
-			MultiplyByWord(_3v0, 3); // Multiply by 3
-			Add(_3v0, vm1);
-			Add(_3v0, v2);
-			ShiftRight(_3v0, 1); // Division by 2
-			DivideBy3(_3v0); // Division by 3
-
-			// T1
-			BigInt_T t1;
-			Resize(t1, std::max(CountSignificantWords(_3v0), CountSignificantWords(vinf)));
-			Copy(t1, _3v0);
-			Sub(t1, vinf);
-
-			// 2*vm1 -> vm1
-			ShiftRight(vm1, 1);
-
-			// 2*vinf -> vinf
-			ShiftRight(vinf, 1);
-
-			// T2
-			BigInt_T t2;
-			Resize(t2, std::max(CountSignificantWords(v1), CountSignificantWords(vm1)) + 1);
-			Copy(t2, v1);
-			Add(t2, vm1);
-			ShiftRight(t2, 1);
-
-			// C0
-			const BigInt_T& c0 = v0;
-
-			// C1
-			BigInt_T c1;
-			Resize(c1, std::max(CountSignificantWords(v1), CountSignificantWords(t1)) + k);
-			Copy(c1, v1);
-			Sub(c1, t1);
-
-			// C2
-			BigInt_T c2;
-			Resize(c2, std::max(CountSignificantWords(t2), std::max(CountSignificantWords(v0), CountSignificantWords(vinf))) + 2 * k);
-			Copy(c2, t2);
-			Sub(c2, v0);
-			Sub(c2, vinf);
-
-			// C3
-			BigInt_T c3;
-			Resize(c3, std::max(CountSignificantWords(t1), CountSignificantWords(t2)) + 3 * k);
-			Copy(c3, t1);
-			Sub(c3, t2);
-
-			// C4
-			BigInt_T c4;
-			Resize(c4, CountSignificantWords(vinf) + 4 * k);
-			Copy(c4, vinf);
-
-			memset(a.Buffer, 0, a.Size * sizeof(WORD));
-			ShiftLeft(c1, 1 * k * sizeof(WORD) * 8);
-			ShiftLeft(c2, 2 * k * sizeof(WORD) * 8);
-			ShiftLeft(c3, 3 * k * sizeof(WORD) * 8);
-			ShiftLeft(c4, 4 * k * sizeof(WORD) * 8);
-			Copy(a, c0);
-			Add(a, c1);
-			Add(a, c2);
-			Add(a, c3);
-			Add(a, c4);
-		};
+		/*
 
-		// Reserve space for result
-		Resize(first, std::max(std::max(first.Size, second.Size), firstSize + secondSize));
+			Both factors are split in pieces of p words and the pieces are used as coefficients of two polynomials,
+			which are multiplied with a cyclic convolution of length K = 2^k (no wrap around occurs, since the
+			product has less than K pieces). The convolution is computed modulo 2^N + 1, where N is large enough
+			to hold every exact coefficient of the product (N >= 2p * word bit size + k + 1) and a multiple of K/2,
+			so that 2^(2N/K) is a K-th root of unity
 
-		// Multiply
-		ToomCook3(first, second);
+		*/
 
-		// Establish sign
-		first.Sign = first.Sign ^ second.Sign;
-	}
+		const std::size_t total = na + nb;
+		std::size_t k = 0, p = 0, n = 0;
+		long double bestCost = 0.0l;
+		for (std::size_t ck = 3; ((std::size_t)1 << ck) <= total; ck++) {
+
+			const std::size_t K = (std::size_t)1 << ck;
+
+			std::size_t cp = (total + K - 1) / K;
+			while ((na + cp - 1) / cp + (nb + cp - 1) / cp - 1 > K)
+				cp++;
+
+			std::size_t cn = (2 * cp * BITS_PER_WORD + ck + 1 + BITS_PER_WORD - 1) / BITS_PER_WORD;
+			while ((2 * cn * BITS_PER_WORD) % K != 0)
+				cn++;
+
+			// Pointwise products plus the three transforms
+			const long double cost = (long double)K * (std::pow((long double)cn, 1.5l) + 3.0l * ck * cn);
+			if (k == 0 || cost < bestCost) {
+
+				bestCost = cost;
+				k = ck;
+				p = cp;
+				n = cn;
+			}
+		}
+
+		const std::size_t K = (std::size_t)1 << k;
+		const std::size_t stride = n + 1;
+
+		// When squaring, the second factor is not transformed at all
+		const bool square = a == b && na == nb;
+
+		BigInt_T fa, fb, scratch;
+		Resize(fa, K * stride);
+		Resize(fb, square ? 1 : K * stride);
+		Resize(scratch, 3 * stride);
+
+		// Split the factors
+		for (std::size_t i = 0; i * p < na; i++)
+			bi_memcpy(fa.Buffer + i * stride, stride * sizeof(WORD), a + i * p, std::min(p, na - i * p) * sizeof(WORD));
+		if (!square)
+			for (std::size_t i = 0; i * p < nb; i++)
+				bi_memcpy(fb.Buffer + i * stride, stride * sizeof(WORD), b + i * p, std::min(p, nb - i * p) * sizeof(WORD));
+
+		// Transform, multiply pointwise and transform back
+		FermatForwardTransform(fa.Buffer, k, n, scratch.Buffer);
+		if (!square)
+			FermatForwardTransform(fb.Buffer, k, n, scratch.Buffer);
+		const WORD* fbBuffer = square ? fa.Buffer : fb.Buffer;
+		for (std::size_t i = 0; i < K; i++)
+			FermatMult(fa.Buffer + i * stride, fa.Buffer + i * stride, fbBuffer + i * stride, n);
+		FermatInverseTransform(fa.Buffer, k, n, scratch.Buffer);
+
+		// Scale by 1/K = 2^(2N - k) and recompose the coefficients
+		BigInt_T result;
+		Resize(result, K * p + stride);
+		for (std::size_t i = 0; i < K; i++) {
+
+			WORD* coeff = fa.Buffer + i * stride;
+			FermatMultBy2Exp(scratch.Buffer + 2 * stride, coeff, n, 2 * n * BITS_PER_WORD - k, scratch.Buffer);
+
+			WORD* dest = result.Buffer + i * p;
+			const WORD carry = AddWords(dest, dest, scratch.Buffer + 2 * stride, stride);
+			AddWord(dest + stride, result.Size - i * p - stride, carry);
+		}
+
+		bi_memcpy(r, total * sizeof(WORD), result.Buffer, total * sizeof(WORD));
+	}
+
+	// --- Number-theoretic transform multiplication ---
+
+	// The number-theoretic transform multiplication mode (automatic, forced on or forced off)
+	static std::atomic<int> s_NTTMode(BI_NTT_MODE);
+
+	// The limb size from which the multiplication switches to the number-theoretic transform (automatic mode only)
+	static std::atomic<std::size_t> s_NTTThreshold(BI_NTT_THRESHOLD);
+
+	void SetNTTMode(int mode) {
+
+		if (mode != BI_NTT_AUTO && mode != BI_NTT_ON && mode != BI_NTT_OFF)
+			throw std::invalid_argument("Invalid number-theoretic transform mode");
+
+		s_NTTMode.store(mode, std::memory_order_relaxed);
+	}
+
+	int GetNTTMode() {
+
+		return s_NTTMode.load(std::memory_order_relaxed);
+	}
+
+	void SetNTTThreshold(std::size_t limbs) {
+
+		s_NTTThreshold.store(limbs, std::memory_order_relaxed);
+	}
+
+	std::size_t GetNTTThreshold() {
+
+		return s_NTTThreshold.load(std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Multiply two 64-bit numbers and store the result in a 128-bit number
+	/// </summary>
+	/// <param name="a">The first number</param>
+	/// <param name="b">The second number</param>
+	/// <param name="low">The low part of the result</param>
+	/// <param name="high">The high part of the result</param>
+	static void MultU64(std::uint64_t a, std::uint64_t b, std::uint64_t& low, std::uint64_t& high) {
+
+		if (sizeof(WORD) == sizeof(std::uint64_t)) {
+
+			WORD l, h;
+			MultUWORD((WORD)a, (WORD)b, l, h);
+			low = l;
+			high = h;
+
+			return;
+		}
+
+		const std::uint64_t aLow = a & 0xFFFFFFFFull;
+		const std::uint64_t aHigh = a >> 32;
+		const std::uint64_t bLow = b & 0xFFFFFFFFull;
+		const std::uint64_t bHigh = b >> 32;
+
+		const std::uint64_t ll = aLow * bLow;
+		const std::uint64_t lh = aLow * bHigh;
+		const std::uint64_t hl = aHigh * bLow;
+		const std::uint64_t hh = aHigh * bHigh;
+
+		const std::uint64_t middle1 = (ll >> 32) + (lh & 0xFFFFFFFFull) + (hl & 0xFFFFFFFFull);
+		const std::uint64_t middle2 = (lh >> 32) + (hl >> 32) + (middle1 >> 32);
+
+		low = (ll & 0xFFFFFFFFull) | (middle1 << 32);
+		high = hh + middle2;
+	}
+
+	// A prime of the form c * 2^k + 1 (lower than 2^63) with its Montgomery constants (R = 2^64)
+	struct NTTPrime {
+
+		// The prime
+		std::uint64_t P;
+
+		// -P^(-1) mod R
+		std::uint64_t NegInv;
+
+		// R^2 mod P
+		std::uint64_t R2;
+
+		// A primitive root modulo P
+		std::uint64_t G;
+
+		// The maximum power of two that divides P - 1 (as exponent)
+		std::size_t MaxLog;
+	};
+
+	/// <summary>
+	/// Adds two residues modulo p
+	/// </summary>
+	static inline std::uint64_t AddMod(std::uint64_t a, std::uint64_t b, std::uint64_t p) {
+
+		const std::uint64_t s = a + b;
+
+		return s >= p ? s - p : s;
+	}
+
+	/// <summary>
+	/// Subtracts two residues modulo p
+	/// </summary>
+	static inline std::uint64_t SubMod(std::uint64_t a, std::uint64_t b, std::uint64_t p) {
+
+		return a >= b ? a - b : a + p - b;
+	}
+
+	/// <summary>
+	/// Montgomery multiplication (a * b / R mod P). The product a * b must be lower than P * R
+	/// </summary>
+	static inline std::uint64_t MontMult(std::uint64_t a, std::uint64_t b, const NTTPrime& prime) {
+
+		std::uint64_t low, high, mLow, mHigh;
+		MultU64(a, b, low, high);
+		MultU64(low * prime.NegInv, prime.P, mLow, mHigh);
+
+		// The low words sum up to zero (mod R), so there is a carry only if the low word is not zero
+		const std::uint64_t t = high + mHigh + (low != 0);
+
+		return t >= prime.P ? t - prime.P : t;
+	}
+
+	/// <summary>
+	/// Raises a number in Montgomery form to the given power
+	/// </summary>
+	static std::uint64_t MontPow(std::uint64_t base, std::uint64_t exp, const NTTPrime& prime) {
+
+		std::uint64_t result = MontMult(1, prime.R2, prime); // R mod P, the Montgomery form of one
+		while (exp) {
+
+			if (exp & 1)
+				result = MontMult(result, base, prime);
+			base = MontMult(base, base, prime);
+			exp >>= 1;
+		}
+
+		return result;
+	}
+
+	/// <summary>
+	/// Computes the Montgomery constants of the given prime
+	/// </summary>
+	static NTTPrime MakeNTTPrime(std::uint64_t p, std::uint64_t g, std::size_t max_log) {
+
+		NTTPrime prime;
+		prime.P = p;
+		prime.G = g;
+		prime.MaxLog = max_log;
+
+		// Newton iteration for the inverse modulo 2^64 (p is its own inverse modulo 8)
+		std::uint64_t inv = p;
+		for (int i = 0; i < 5; i++)
+			inv *= 2 - p * inv;
+		prime.NegInv = 0 - inv;
+
+		// R^2 mod P, doubling R mod P 64 times
+		std::uint64_t r = (0 - p) % p;
+		for (int i = 0; i < 64; i++)
+			r = AddMod(r, r, p);
+		prime.R2 = r;
+
+		return prime;
+	}
+
+	// The three primes used by the number-theoretic transform and the constants of the Chinese remainder theorem
+	struct NTTContext {
+
+		NTTPrime Primes[3];
+
+		// P0^(-1) mod P1 (Montgomery form)
+		std::uint64_t InvP0ModP1;
+
+		// (P0 * P1)^(-1) mod P2 (Montgomery form)
+		std::uint64_t InvP0P1ModP2;
+
+		// P0 mod P2 (Montgomery form)
+		std::uint64_t P0ModP2;
+
+		// P0 * P1 (as double word)
+		std::uint64_t P0P1Low, P0P1High;
+
+		NTTContext() {
+
+			Primes[0] = MakeNTTPrime(4179340454199820289ull, 3, 57); // 29 * 2^57 + 1
+			Primes[1] = MakeNTTPrime(2053641430080946177ull, 7, 55); // 57 * 2^55 + 1
+			Primes[2] = MakeNTTPrime(1945555039024054273ull, 5, 56); // 27 * 2^56 + 1
+
+			const NTTPrime& p1 = Primes[1];
+			const NTTPrime& p2 = Primes[2];
+
+			// Inverses with Fermat's little theorem
+			InvP0ModP1 = MontPow(MontMult(Primes[0].P % p1.P, p1.R2, p1), p1.P - 2, p1);
+
+			P0ModP2 = MontMult(Primes[0].P % p2.P, p2.R2, p2);
+			const std::uint64_t p0p1 = MontMult(P0ModP2, MontMult(p1.P % p2.P, p2.R2, p2), p2);
+			InvP0P1ModP2 = MontPow(p0p1, p2.P - 2, p2);
+
+			MultU64(Primes[0].P, p1.P, P0P1Low, P0P1High);
+		}
+	};
+
+	/// <summary>
+	/// In-place decimation-in-frequency transform (natural order input, bit-reversed order output)
+	/// </summary>
+	/// <param name="data">The residues (normal form)</param>
+	/// <param name="size">The transform length (a power of two)</param>
+	/// <param name="roots">The powers of the size-th root of unity, from 0 to size / 2 (Montgomery form)</param>
+	static void NTTForward(std::uint64_t* data, std::size_t size, const std::uint64_t* roots, const NTTPrime& prime) {
+
+		const std::uint64_t p = prime.P;
+		for (std::size_t len = size; len >= 2; len >>= 1) {
+
+			const std::size_t half = len / 2;
+			const std::size_t step = size / len;
+			for (std::size_t start = 0; start < size; start += len) {
+
+				for (std::size_t j = 0; j < half; j++) {
+
+					const std::uint64_t u = data[start + j];
+					const std::uint64_t v = data[start + j + half];
+					data[start + j] = AddMod(u, v, p);
+					data[start + j + half] = MontMult(SubMod(u, v, p), roots[j * step], prime);
+				}
+			}
+		}
+	}
+
+	/// <summary>
+	/// In-place decimation-in-time inverse transform (bit-reversed order input, natural order output). The result is not scaled
+	/// </summary>
+	/// <param name="data">The residues (normal form)</param>
+	/// <param name="size">The transform length (a power of two)</param>
+	/// <param name="roots">The powers of the inverse size-th root of unity, from 0 to size / 2 (Montgomery form)</param>
+	static void NTTInverse(std::uint64_t* data, std::size_t size, const std::uint64_t* roots, const NTTPrime& prime) {
+
+		const std::uint64_t p = prime.P;
+		for (std::size_t len = 2; len <= size; len <<= 1) {
+
+			const std::size_t half = len / 2;
+			const std::size_t step = size / len;
+			for (std::size_t start = 0; start < size; start += len) {
+
+				for (std::size_t j = 0; j < half; j++) {
+
+					const std::uint64_t u = data[start + j];
+					const std::uint64_t v = MontMult(data[start + j + half], roots[j * step], prime);
+					data[start + j] = AddMod(u, v, p);
+					data[start + j + half] = SubMod(u, v, p);
+				}
+			}
+		}
+	}
+
+	/// <summary>
+	/// Multiplies two word arrays with a number-theoretic transform over three primes, recombining the results with the Chinese remainder theorem
+	/// </summary>
+	/// <param name="r">The product (na + nb words, it must not overlap the factors)</param>
+	/// <param name="a">The first factor</param>
+	/// <param name="na">The first factor size in words</param>
+	/// <param name="b">The second factor</param>
+	/// <param name="nb">The second factor size in words</param>
+	static void NumberTheoreticTransform(WORD* r, const WORD* a, std::size_t na, const WORD* b, std::size_t nb) {
+
+		static const NTTContext context;
+
+		/*
+
+			Both factors are split in 64-bit pieces. Every coefficient of the product is lower than
+			size * 2^128, which is far below P0 * P1 * P2 (about 2^183) for any allowed size
+
+		*/
+
+		const std::size_t aPieces = (na * sizeof(WORD) + 7) / 8;
+		const std::size_t bPieces = (nb * sizeof(WORD) + 7) / 8;
+		const std::size_t pieces = aPieces + bPieces;
+
+		std::size_t log = 0;
+		while (((std::size_t)1 << log) < pieces - 1)
+			log++;
+		const std::size_t size = (std::size_t)1 << log;
+
+		if (log > context.Primes[1].MaxLog)
+			throw std::length_error("Number-theoretic transform: the factors are too large");
+
+		// When squaring, the second factor is not transformed at all
+		const bool square = a == b && na == nb;
+
+		std::vector<std::uint64_t> aData(aPieces, 0), bData(square ? 0 : bPieces, 0);
+		bi_memcpy(aData.data(), aPieces * 8, a, na * sizeof(WORD));
+		if (!square)
+			bi_memcpy(bData.data(), bPieces * 8, b, nb * sizeof(WORD));
+
+		std::vector<std::uint64_t> residues[3];
+		std::vector<std::uint64_t> fb(square ? 0 : size), roots(size / 2 + 1), inverseRoots(size / 2 + 1);
+		for (std::size_t i = 0; i < 3; i++) {
+
+			const NTTPrime& prime = context.Primes[i];
+			const std::uint64_t p = prime.P;
+
+			// Primitive size-th root of unity and its inverse (Montgomery form)
+			const std::uint64_t root = MontPow(MontMult(prime.G, prime.R2, prime), (p - 1) >> log, prime);
+			const std::uint64_t inverseRoot = MontPow(root, size - 1, prime);
+			roots[0] = inverseRoots[0] = MontMult(1, prime.R2, prime);
+			for (std::size_t j = 1; j <= size / 2; j++) {
+
+				roots[j] = MontMult(roots[j - 1], root, prime);
+				inverseRoots[j] = MontMult(inverseRoots[j - 1], inverseRoot, prime);
+			}
+
+			std::vector<std::uint64_t>& fa = residues[i];
+			fa.assign(size, 0);
+			for (std::size_t j = 0; j < aPieces; j++)
+				fa[j] = aData[j] % p;
+			NTTForward(fa.data(), size, roots.data(), prime);
+
+			// The pointwise products are a * b / R
+			if (square) {
+
+				for (std::size_t j = 0; j < size; j++)
+					fa[j] = MontMult(fa[j], fa[j], prime);
+			}
+
+			else {
+
+				std::fill(fb.begin(), fb.end(), 0);
+				for (std::size_t j = 0; j < bPieces; j++)
+					fb[j] = bData[j] % p;
+				NTTForward(fb.data(), size, roots.data(), prime);
+
+				for (std::size_t j = 0; j < size; j++)
+					fa[j] = MontMult(fa[j], fb[j], prime);
+			}
+
+			NTTInverse(fa.data(), size, inverseRoots.data(), prime);
+
+			// Multiply by R / size (R^2 / size in Montgomery form)
+			const std::uint64_t inverseSize = MontMult(p - (p - 1) / size, prime.R2, prime);
+			const std::uint64_t scale = MontMult(inverseSize, prime.R2, prime);
+			for (std::size_t j = 0; j < size; j++)
+				fa[j] = MontMult(fa[j], scale, prime);
+		}
+
+		// Chinese remainder theorem (Garner's algorithm) and recomposition
+		const NTTPrime& p1 = context.Primes[1];
+		const NTTPrime& p2 = context.Primes[2];
+		std::vector<std::uint64_t> result(pieces + 3, 0);
+		for (std::size_t j = 0; j < pieces - 1; j++) {
+
+			const std::uint64_t x0 = residues[0][j];
+			const std::uint64_t x1 = residues[1][j];
+			const std::uint64_t x2 = residues[2][j];
+
+			// coefficient = v0 + v1 * P0 + v2 * P0 * P1
+			const std::uint64_t v0 = x0;
+			const std::uint64_t v1 = MontMult(SubMod(x1, v0 % p1.P, p1.P), context.InvP0ModP1, p1);
+			const std::uint64_t partial = AddMod(v0 % p2.P, MontMult(v1, context.P0ModP2, p2), p2.P);
+			const std::uint64_t v2 = MontMult(SubMod(x2, partial, p2.P), context.InvP0P1ModP2, p2);
+
+			std::uint64_t c[3], low, high;
+			MultU64(v1, context.Primes[0].P, c[0], c[1]);
+			c[0] += v0;
+			c[1] += c[0] < v0;
+			MultU64(v2, context.P0P1Low, low, high);
+			c[0] += low;
+			high += c[0] < low;
+			c[1] += high;
+			c[2] = c[1] < high;
+			MultU64(v2, context.P0P1High, low, high);
+			c[1] += low;
+			c[2] += high + (c[1] < low);
+
+			std::uint64_t carry = 0;
+			for (std::size_t k = 0; k < 3; k++) {
+
+				const std::uint64_t sum = result[j + k] + carry;
+				carry = sum < carry;
+				result[j + k] = sum + c[k];
+				carry += result[j + k] < sum;
+			}
+
+			for (std::size_t k = j + 3; carry && k < result.size(); k++) {
+
+				result[k] += carry;
+				carry = result[k] < carry;
+			}
+		}
+
+		bi_memcpy(r, (na + nb) * sizeof(WORD), result.data(), (na + nb) * sizeof(WORD));
+	}
+
+	// A multiplication kernel that works on word arrays (the product must not overlap the factors)
+	typedef void(*MultKernel)(WORD* r, const WORD* a, std::size_t na, const WORD* b, std::size_t nb);
+
+	/// <summary>
+	/// Selects the transform-based multiplication algorithm for the given factor sizes
+	/// </summary>
+	/// <param name="a_size">The first factor size in words</param>
+	/// <param name="b_size">The second factor size in words</param>
+	/// <returns>The multiplication kernel, or nullptr if the recursive algorithms should be used</returns>
+	static MultKernel SelectTransform(std::size_t a_size, std::size_t b_size) {
+
+		const int mode = s_NTTMode.load(std::memory_order_relaxed);
+		if (mode == BI_NTT_ON || (mode == BI_NTT_AUTO && std::min(a_size, b_size) >= s_NTTThreshold.load(std::memory_order_relaxed)))
+			return NumberTheoreticTransform;
+
+		if (std::min(a_size, b_size) >= s_SSAThreshold.load(std::memory_order_relaxed))
+			return SchonhageStrassen;
+
+		return nullptr;
+	}
+
+	/// <summary>
+	/// Multiplies a word array by a word and adds the result to another word array (r += a * c)
+	/// </summary>
+	/// <param name="r">The word array where the result will be accumulated</param>
+	/// <param name="a">The word array to multiply</param>
+	/// <param name="n">The arrays' length</param>
+	/// <param name="c">The word</param>
+	/// <returns>The carry out of the most significant word</returns>
+	static WORD AddMultWord(WORD* r, const WORD* a, std::size_t n, WORD c) {
+
+#if defined(BI_X64_KERNELS)
+		if (s_HasBMI2AndADX && n != 0 && s_UseBMI2AndADX.load(std::memory_order_relaxed))
+			return AddMultWordADX(r, a, n, c);
+#endif
+
+		WORD carry = 0;
+		for (std::size_t i = 0; i < n; i++) {
+
+			WORD low, high;
+			MultUWORD(a[i], c, low, high);
+
+			low += carry;
+			high += low < carry;
+			r[i] += low;
+			high += r[i] < low;
+			carry = high;
+		}
+
+		return carry;
+	}
+
+	/// <summary>
+	/// Multiplies two word arrays with the schoolbook method, accumulating one row per word of the first factor directly into the product.
+	/// The product can be the first factor itself (in that case, its buffer must be at least na + nb words long)
+	/// </summary>
+	/// <param name="r">The product (na + nb words, it must not overlap the second factor)</param>
+	/// <param name="a">The first factor</param>
+	/// <param name="na">The first factor size in words</param>
+	/// <param name="b">The second factor</param>
+	/// <param name="nb">The second factor size in words</param>
+	static void BasecaseMult(WORD* r, const WORD* a, std::size_t na, const WORD* b, std::size_t nb) {
+
+		if (r != a)
+			bi_memcpy(r, na * sizeof(WORD), a, na * sizeof(WORD));
+		memset(r + na, 0, nb * sizeof(WORD));
+
+		// The rows are accumulated from the most significant one, so every word of the first factor
+		// is read before the lower rows (the only ones that could overwrite it) are added
+		for (std::size_t j = na; j--;) {
+
+			const WORD c = r[j];
+			r[j] = 0;
+			const WORD carry = AddMultWord(r + j, b, nb, c);
+			AddWord(r + j + nb, na - j, carry);
+		}
+	}
+
+	/// <summary>
+	/// Squares a word array with the schoolbook method, computing every cross product only once
+	/// </summary>
+	/// <param name="r">The result (2n words, it must not overlap the source)</param>
+	/// <param name="a">The word array to square</param>
+	/// <param name="n">The array's length</param>
+	static void BasecaseSquare(WORD* r, const WORD* a, std::size_t n) {
+
+		memset(r, 0, 2 * n * sizeof(WORD));
+
+		// Cross products (a_i * a_j with i < j)
+		for (std::size_t i = 0; i + 1 < n; i++)
+			r[i + n] = AddMultWord(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+
+		// Double them
+		ShiftLeftWords(r, r, 2 * n, 1);
+
+		// Add the squares on the diagonal
+		WORD carry = 0;
+		for (std::size_t i = 0; i < n; i++) {
+
+			WORD low, high;
+			MultUWORD(a[i], a[i], low, high);
+
+			WORD sum = r[2 * i] + low;
+			WORD c = sum < low;
+			r[2 * i] = sum + carry;
+			c += r[2 * i] < sum;
+
+			sum = r[2 * i + 1] + high;
+			carry = sum < high;
+			r[2 * i + 1] = sum + c;
+			carry += r[2 * i + 1] < sum;
+		}
+	}
+
+	// --- Recursive multiplication ---
+
+	// The lowest Karatsuba threshold (the unbalanced Toom-Cook splits need factors of at least this many words)
+	constexpr std::size_t KARATSUBA_MIN_THRESHOLD = 8;
+
+	// Factors at least this long (in words) are multiplied with the Karatsuba algorithm
+	static std::atomic<std::size_t> s_KaratsubaThreshold(BI_KARATSUBA_THRESHOLD < KARATSUBA_MIN_THRESHOLD ? KARATSUBA_MIN_THRESHOLD : BI_KARATSUBA_THRESHOLD);
+
+	// Factors at least this long (in words) are multiplied with the Toom-Cook 3-Way algorithm
+	static std::atomic<std::size_t> s_ToomCook3Threshold(BI_TOOM_COOK_3_THRESHOLD);
+
+	// Factors at least this long (in words) are multiplied with the Toom-Cook 4-Way algorithm
+	static std::atomic<std::size_t> s_ToomCook4Threshold(BI_TOOM_COOK_4_THRESHOLD);
+
+	// Factors at least this long (in words) are multiplied with the Toom-Cook 6-Way algorithm
+	static std::atomic<std::size_t> s_ToomCook6Threshold(BI_TOOM_COOK_6_THRESHOLD);
+
+	// Factors at least this long (in words) are multiplied with the Toom-Cook 8-Way algorithm
+	static std::atomic<std::size_t> s_ToomCook8Threshold(BI_TOOM_COOK_8_THRESHOLD);
+
+	// The lowest Burnikel-Ziegler threshold (the recursion halves the divisor)
+	constexpr std::size_t BURNIKEL_ZIEGLER_MIN_THRESHOLD = 2;
+
+	// Divisions whose divisor and quotient are both at least this long (in words) use the Burnikel-Ziegler algorithm
+	static std::atomic<std::size_t> s_BurnikelZieglerThreshold(BI_BURNIKEL_ZIEGLER_THRESHOLD < BURNIKEL_ZIEGLER_MIN_THRESHOLD ? BURNIKEL_ZIEGLER_MIN_THRESHOLD : BI_BURNIKEL_ZIEGLER_THRESHOLD);
+
+	// The lowest Newton threshold (the reciprocal iteration needs a few words of precision)
+	constexpr std::size_t NEWTON_MIN_THRESHOLD = 2;
+
+	// Divisions whose divisor and quotient are both at least this long (in words) multiply by the reciprocal of the divisor, computed with Newton's
+	// method, if the same divisor has already been used
+	static std::atomic<std::size_t> s_NewtonThreshold(BI_NEWTON_THRESHOLD < NEWTON_MIN_THRESHOLD ? NEWTON_MIN_THRESHOLD : BI_NEWTON_THRESHOLD);
+
+	// The number of threads used by the multiplication (1 means that it is serial)
+	static std::atomic<std::size_t> s_ThreadCount(BI_THREAD_COUNT < 1 ? 1 : BI_THREAD_COUNT);
+
+	// Products whose factors are both at least this long (in words) are split among the threads
+	static std::atomic<std::size_t> s_ParallelThreshold(BI_PARALLEL_THRESHOLD < KARATSUBA_MIN_THRESHOLD ? KARATSUBA_MIN_THRESHOLD : BI_PARALLEL_THRESHOLD);
+
+	// The thread pool shared by all the parallel multiplications (created on first use)
+	static std::unique_ptr<ThreadPool> s_ThreadPool;
+	static std::mutex s_ThreadPoolMutex;
+
+	void SetThreadCount(std::size_t threads) {
+
+		if (threads == 0)
+			threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+
+		std::lock_guard<std::mutex> lock(s_ThreadPoolMutex);
+		s_ThreadCount.store(threads, std::memory_order_relaxed);
+
+		// The pool is recreated with the new size on the next parallel multiplication
+		if (s_ThreadPool && s_ThreadPool->GetThreadCount() != threads)
+			s_ThreadPool.reset();
+	}
+
+	std::size_t GetThreadCount() {
+
+		return s_ThreadCount.load(std::memory_order_relaxed);
+	}
+
+	void SetParallelThreshold(std::size_t limbs) {
+
+		s_ParallelThreshold.store(std::max(limbs, KARATSUBA_MIN_THRESHOLD), std::memory_order_relaxed);
+	}
+
+	std::size_t GetParallelThreshold() {
+
+		return s_ParallelThreshold.load(std::memory_order_relaxed);
+	}
+
+	void SetThreshold(int algorithm, std::size_t limbs) {
+
+		switch (algorithm) {
+
+		case BI_KARATSUBA:
+			s_KaratsubaThreshold.store(std::max(limbs, KARATSUBA_MIN_THRESHOLD), std::memory_order_relaxed);
+			break;
+
+		case BI_TOOM_COOK_3:
+			s_ToomCook3Threshold.store(limbs, std::memory_order_relaxed);
+			break;
+
+		case BI_TOOM_COOK_4:
+			s_ToomCook4Threshold.store(limbs, std::memory_order_relaxed);
+			break;
+
+		case BI_TOOM_COOK_6:
+			s_ToomCook6Threshold.store(limbs, std::memory_order_relaxed);
+			break;
+
+		case BI_TOOM_COOK_8:
+			s_ToomCook8Threshold.store(limbs, std::memory_order_relaxed);
+			break;
+
+		case BI_NTT:
+			SetNTTThreshold(limbs);
+			break;
+
+		case BI_SSA:
+			SetSSAThreshold(limbs);
+			break;
+
+		case BI_PARALLEL:
+			SetParallelThreshold(limbs);
+			break;
+
+		case BI_BURNIKEL_ZIEGLER:
+			s_BurnikelZieglerThreshold.store(std::max(limbs, BURNIKEL_ZIEGLER_MIN_THRESHOLD), std::memory_order_relaxed);
+			break;
+
+		case BI_NEWTON:
+			s_NewtonThreshold.store(std::max(limbs, NEWTON_MIN_THRESHOLD), std::memory_order_relaxed);
+			break;
+
+		default:
+			throw std::invalid_argument("Invalid threshold algorithm");
+		}
+	}
+
+	std::size_t GetThreshold(int algorithm) {
+
+		switch (algorithm) {
+
+		case BI_KARATSUBA:
+			return s_KaratsubaThreshold.load(std::memory_order_relaxed);
+
+		case BI_TOOM_COOK_3:
+			return s_ToomCook3Threshold.load(std::memory_order_relaxed);
+
+		case BI_TOOM_COOK_4:
+			return s_ToomCook4Threshold.load(std::memory_order_relaxed);
+
+		case BI_TOOM_COOK_6:
+			return s_ToomCook6Threshold.load(std::memory_order_relaxed);
+
+		case BI_TOOM_COOK_8:
+			return s_ToomCook8Threshold.load(std::memory_order_relaxed);
+
+		case BI_NTT:
+			return GetNTTThreshold();
+
+		case BI_SSA:
+			return GetSSAThreshold();
+
+		case BI_PARALLEL:
+			return GetParallelThreshold();
+
+		case BI_BURNIKEL_ZIEGLER:
+			return s_BurnikelZieglerThreshold.load(std::memory_order_relaxed);
+
+		case BI_NEWTON:
+			return s_NewtonThreshold.load(std::memory_order_relaxed);
+
+		default:
+			throw std::invalid_argument("Invalid threshold algorithm");
+		}
+	}
+
+	/// <returns>The thread pool, sized with the current thread count</returns>
+	static ThreadPool& GetThreadPool() {
+
+		std::lock_guard<std::mutex> lock(s_ThreadPoolMutex);
+		if (!s_ThreadPool)
+			s_ThreadPool.reset(new ThreadPool(s_ThreadCount.load(std::memory_order_relaxed)));
+
+		return *s_ThreadPool;
+	}
+
+	/// <summary>
+	/// A stack-like scratch memory arena. It is sized up front from the factor lengths, so the whole Karatsuba and Toom-Cook
+	/// recursion draws its temporaries from a single allocation. The sizes are upper bounds, so a reservation that does not fit is a
+	/// sizing bug: debug builds assert, release builds serve it with a heap block of its own, which is freed when released. The memory
+	/// is not initialized
+	/// </summary>
+	class ScratchArena {
+
+	public:
+
+		ScratchArena(std::size_t size)
+			: m_Buffer(nullptr), m_Size(size), m_Top(0)
+		{
+
+			if (size != 0)
+				m_Buffer = Allocate(size);
+		}
+
+		~ScratchArena() {
+
+			Release(0);
+			delete[] m_Buffer;
+		}
+
+		ScratchArena(const ScratchArena&) = delete;
+		ScratchArena& operator=(const ScratchArena&) = delete;
+
+		/// <summary>
+		/// Reserves some words on top of the arena
+		/// </summary>
+		/// <param name="size">The number of words</param>
+		/// <returns>The reserved words</returns>
+		WORD* Alloc(std::size_t size) {
+
+			WORD* ptr;
+			if (m_Top + size <= m_Size)
+				ptr = m_Buffer + m_Top;
+			else {
+
+				assert(!"The scratch arena is smaller than its bound");
+
+				m_Overflow.reserve(m_Overflow.size() + 1);
+				ptr = Allocate(size);
+				m_Overflow.push_back(std::make_pair(m_Top, ptr));
+			}
+
+			m_Top += size;
+			return ptr;
+		}
+
+		/// <returns>The current top of the arena (to be passed to Release)</returns>
+		std::size_t Mark() const {
+
+			return m_Top;
+		}
+
+		/// <summary>
+		/// Releases all the words reserved after the given mark
+		/// </summary>
+		/// <param name="mark">The mark</param>
+		void Release(std::size_t mark) {
+
+			assert(mark <= m_Top);
+
+			while (!m_Overflow.empty() && m_Overflow.back().first >= mark) {
+
+				delete[] m_Overflow.back().second;
+				m_Overflow.pop_back();
+			}
+
+			m_Top = mark;
+		}
+
+	private:
+
+		static WORD* Allocate(std::size_t size) {
+
+			try {
+
+				return new WORD[size];
+			}
+
+			catch (const std::bad_alloc&) {
+
+				throw std::runtime_error("Memory allocation failed: cannot allocate " + std::to_string(size * sizeof(WORD)) + " bytes");
+			}
+		}
+
+		WORD* m_Buffer;
+		std::size_t m_Size;
+		std::size_t m_Top;
+		std::vector<std::pair<std::size_t, WORD*>> m_Overflow;
+	};
+
+	/// <summary>
+	/// Adds a word array to a longer (or equally long) one (r += a)
+	/// </summary>
+	/// <param name="r">The word array where the result will be accumulated</param>
+	/// <param name="rn">The result length</param>
+	/// <param name="a">The word array to add</param>
+	/// <param name="an">The length of the array to add (less than or equal to rn)</param>
+	/// <returns>The carry out of the most significant word</returns>
+	static WORD AddWordsTo(WORD* r, std::size_t rn, const WORD* a, std::size_t an) {
+
+		const WORD carry = AddWords(r, r, a, an);
+
+		return AddWord(r + an, rn - an, carry);
+	}
+
+	/// <summary>
+	/// Subtracts a word array from a longer (or equally long) one (r -= a)
+	/// </summary>
+	/// <param name="r">The word array where the result will be stored</param>
+	/// <param name="rn">The result length</param>
+	/// <param name="a">The word array to subtract</param>
+	/// <param name="an">The length of the array to subtract (less than or equal to rn)</param>
+	/// <returns>The borrow out of the most significant word</returns>
+	static WORD SubWordsFrom(WORD* r, std::size_t rn, const WORD* a, std::size_t an) {
+
+		const WORD borrow = SubWords(r, r, a, an);
+
+		return SubWord(r + an, rn - an, borrow);
+	}
+
+	/// <summary>
+	/// Shifts a word array to the right by less than a word. The result can be the source itself
+	/// </summary>
+	/// <param name="r">The result</param>
+	/// <param name="a">The word array</param>
+	/// <param name="n">The arrays' length</param>
+	/// <param name="bits">The shift amount (between 1 and the word bit size minus one)</param>
+	/// <returns>The bits shifted out of the least significant word (in the high bits)</returns>
+	static WORD ShiftRightWords(WORD* r, const WORD* a, std::size_t n, unsigned int bits) {
+
+		constexpr unsigned int W = sizeof(WORD) * 8;
+
+		WORD out = 0;
+		for (std::size_t i = n; i--;) {
+
+			const WORD v = a[i];
+			r[i] = (v >> bits) | out;
+			out = v << (W - bits);
+		}
+
+		return out;
+	}
+
+	/// <summary>
+	/// Compares two word arrays of the same length
+	/// </summary>
+	/// <param name="a">The first word array</param>
+	/// <param name="b">The second word array</param>
+	/// <param name="n">The arrays' length</param>
+	/// <returns>1 if a is greater than b, -1 if a is less than b and 0 if they are equal</returns>
+	static int CompareWords(const WORD* a, const WORD* b, std::size_t n) {
+
+		for (std::size_t i = n; i--;)
+			if (a[i] != b[i])
+				return a[i] > b[i] ? 1 : -1;
+
+		return 0;
+	}
+
+	/// <summary>
+	/// Multiplies a word array by a word. The result can be the source itself
+	/// </summary>
+	/// <param name="r">The result</param>
+	/// <param name="a">The word array to multiply</param>
+	/// <param name="n">The arrays' length</param>
+	/// <param name="c">The word</param>
+	/// <returns>The carry out of the most significant word</returns>
+	static WORD MultWord(WORD* r, const WORD* a, std::size_t n, WORD c) {
+
+		WORD carry = 0;
+		for (std::size_t i = 0; i < n; i++) {
+
+			WORD low, high;
+			MultUWORD(a[i], c, low, high);
+
+			low += carry;
+			high += low < carry;
+			r[i] = low;
+			carry = high;
+		}
+
+		return carry;
+	}
+
+	/// <summary>
+	/// Multiplies a word array by a word and subtracts the result from another word array (r -= a * c)
+	/// </summary>
+	/// <param name="r">The word array where the result will be stored</param>
+	/// <param name="a">The word array to multiply</param>
+	/// <param name="n">The arrays' length</param>
+	/// <param name="c">The word</param>
+	/// <returns>The borrow out of the most significant word</returns>
+	static WORD SubMultWord(WORD* r, const WORD* a, std::size_t n, WORD c) {
+
+		WORD borrow = 0;
+		for (std::size_t i = 0; i < n; i++) {
+
+			WORD low, high;
+			MultUWORD(a[i], c, low, high);
+
+			low += borrow;
+			high += low < borrow;
+			const WORD t = r[i];
+			r[i] = t - low;
+			high += t < low;
+			borrow = high;
+		}
+
+		return borrow;
+	}
+
+	/// <summary>
+	/// Negates a word array in two's complement
+	/// </summary>
+	/// <param name="r">The word array</param>
+	/// <param name="n">The array's length</param>
+	static void NegateWords(WORD* r, std::size_t n) {
+
+		for (std::size_t i = 0; i < n; i++)
+			r[i] = ~r[i];
+		AddWord(r, n, 1);
+	}
+
+	/// <summary>
+	/// Computes the inverse of an odd word modulo 2^(word bits) with Newton's method, which doubles the number of correct low bits at every step
+	/// </summary>
+	/// <param name="m">The odd word</param>
+	/// <returns>m^-1 mod 2^(word bits)</returns>
+	static WORD InverseWord(WORD m) {
+
+		// m * m = 1 mod 8, so the first 3 bits are already correct
+		WORD x = m;
+		for (int i = 0; i < 5; i++)
+			x *= 2 - m * x;
+
+		return x;
+	}
+
+	// The inverse of 3 modulo 2^64 (3 * 0xAAAAAAAAAAAAAAAB = 2^65 + 1), for the Toom-Cook 3-way interpolation
+	constexpr WORD INVERSE_3 = 0xAAAAAAAAAAAAAAAB;
+
+	// The inverse of 5 modulo 2^64 (5 * 0xCCCCCCCCCCCCCCCD = 2^66 + 1), for the Toom-Cook 4-way interpolation
+	constexpr WORD INVERSE_5 = 0xCCCCCCCCCCCCCCCD;
+
+	/// <summary>
+	/// Divides a word array in two's complement by an odd word with Hensel's (2-adic) method, one full word at a time: every quotient word is
+	/// the low word of the partial dividend times the inverse of the divisor. The division must be exact
+	/// </summary>
+	/// <param name="r">The word array (also the quotient)</param>
+	/// <param name="n">The array's length</param>
+	/// <param name="d">The odd divisor</param>
+	/// <param name="inverse">d^-1 mod 2^(word bits) (see InverseWord)</param>
+	static void DivExactOddWord(WORD* r, std::size_t n, WORD d, WORD inverse) {
+
+		WORD borrow = 0;
+		for (std::size_t i = 0; i < n; i++) {
+
+			const WORD s = r[i] - borrow;
+			const WORD b1 = r[i] < borrow;
+			const WORD q = s * inverse;
+			r[i] = q;
+
+			WORD low, high;
+			MultUWORD(q, d, low, high);
+			borrow = high + b1;
+		}
+	}
+
+	/// <summary>
+	/// Divides a word array in two's complement by a word with Hensel's (2-adic) method. The division must be exact
+	/// </summary>
+	/// <param name="r">The word array (also the quotient)</param>
+	/// <param name="n">The array's length</param>
+	/// <param name="d">The divisor (different from zero)</param>
+	static void DivExactSignedWord(WORD* r, std::size_t n, WORD d) {
+
+		constexpr unsigned int W = sizeof(WORD) * 8;
+
+		// Powers of two are shifted out, keeping the sign
+		unsigned int shift = 0;
+		while ((d & 1) == 0) {
+
+			d >>= 1;
+			shift++;
+		}
+
+		if (shift) {
+
+			const WORD sign = r[n - 1] >> (W - 1);
+			ShiftRightWords(r, r, n, shift);
+			if (sign)
+				r[n - 1] |= ~(WORD)0 << (W - shift);
+		}
+
+		if (d != 1)
+			DivExactOddWord(r, n, d, InverseWord(d));
+	}
+
+	/// <summary>
+	/// Solves a Vandermonde system in place with Newton's divided differences. Given the values of a polynomial with integer coefficients
+	/// in n increasing integer nodes, it replaces them with the polynomial coefficients (the lowest degree first). Every step is an exact
+	/// division or a multiplication by a word, so it is the interpolation sequence used by the higher-order Toom-Cook algorithms
+	/// </summary>
+	/// <param name="values">The values (two's complement word arrays, overwritten with the coefficients)</param>
+	/// <param name="nodes">The nodes in increasing order</param>
+	/// <param name="n">The number of nodes</param>
+	/// <param name="w">The values' length in words</param>
+	static void NewtonInterpolate(WORD* const* values, const WORD* nodes, std::size_t n, std::size_t w) {
+
+		// Divided differences
+		for (std::size_t j = 1; j < n; j++) {
+
+			for (std::size_t i = n - 1; i >= j; i--) {
+
+				SubWords(values[i], values[i], values[i - 1], w);
+				DivExactSignedWord(values[i], w, nodes[i] - nodes[i - j]);
+			}
+		}
+
+		// Newton form to monomial form
+		for (std::size_t j = n - 1; j--;)
+			for (std::size_t i = j; i + 1 < n; i++)
+				SubMultWord(values[i], values[i + 1], w, nodes[j]);
+	}
+
+	/// <summary>
+	/// Toom-Cook 3-Way evaluation. Evaluates the polynomial a0 + a1*x + a2*x^2 in 1, -1 and 2
+	/// </summary>
+	/// <param name="a">The number to split (a0 and a1 are k words long, a2 is s words long)</param>
+	/// <param name="k">The split size in words</param>
+	/// <param name="s">The most significant part size in words (between 1 and k)</param>
+	/// <param name="p1">The value in 1 (k + 1 words)</param>
+	/// <param name="pm1">The absolute value in -1 (k + 1 words)</param>
+	/// <param name="p2">The value in 2 (k + 1 words)</param>
+	/// <returns>True if the value in -1 is negative</returns>
+	static bool ToomCook3Evaluate(const WORD* a, std::size_t k, std::size_t s, WORD* p1, WORD* pm1, WORD* p2) {
+
+		const WORD* a0 = a;
+		const WORD* a1 = a + k;
+		const WORD* a2 = a + 2 * k;
+
+		// P1 = A0 + A2
+		bi_memcpy(p1, k * sizeof(WORD), a0, k * sizeof(WORD));
+		p1[k] = AddWordsTo(p1, k, a2, s);
+
+		// Pm1 = |A0 - A1 + A2|
+		bool negative = false;
+		if (p1[k] == 0 && CompareWords(p1, a1, k) < 0) {
+
+			SubWords(pm1, a1, p1, k);
+			pm1[k] = 0;
+			negative = true;
+		}
+
+		else {
+
+			bi_memcpy(pm1, (k + 1) * sizeof(WORD), p1, (k + 1) * sizeof(WORD));
+			SubWordsFrom(pm1, k + 1, a1, k);
+		}
+
+		// P1 = A0 + A1 + A2
+		AddWordsTo(p1, k + 1, a1, k);
+
+		// P2 = A0 + 2*A1 + 4*A2 = ((2*A2 + A1) * 2) + A0
+		memset(p2, 0, (k + 1) * sizeof(WORD));
+		bi_memcpy(p2, (k + 1) * sizeof(WORD), a2, s * sizeof(WORD));
+		ShiftLeftWords(p2, p2, k + 1, 1);
+		AddWordsTo(p2, k + 1, a1, k);
+		ShiftLeftWords(p2, p2, k + 1, 1);
+		AddWordsTo(p2, k + 1, a0, k);
+
+		return negative;
+	}
+
+	/// <summary>
+	/// Toom-Cook 3-Way interpolation. Recovers the product coefficients from the values of the product polynomial in 0, 1, -1, 2 and infinity
+	/// (with Bodrato's sequence, where every intermediate value is non-negative) and recomposes the product
+	/// </summary>
+	/// <param name="r">The product (it already holds the value in 0 in the first 2k words and the value in infinity from word 4k)</param>
+	/// <param name="k">The split size in words</param>
+	/// <param name="inf_size">The value in infinity size in words</param>
+	/// <param name="v1">The value in 1 (2k + 2 words, overwritten)</param>
+	/// <param name="vm1">The absolute value in -1 (2k + 2 words, overwritten)</param>
+	/// <param name="vm1_negative">True if the value in -1 is negative</param>
+	/// <param name="v2">The value in 2 (2k + 2 words, overwritten)</param>
+	static void ToomCook3Interpolate(WORD* r, std::size_t k, std::size_t inf_size, WORD* v1, WORD* vm1, bool vm1_negative, WORD* v2) {
+
+		const std::size_t n = 2 * k + 2;
+		const std::size_t size = 4 * k + inf_size;
+		const WORD* v0 = r;
+		const WORD* vinf = r + 4 * k;
+
+		// V2 = (V2 - Vm1) / 3
+		if (vm1_negative)
+			AddWords(v2, v2, vm1, n);
+		else
+			SubWords(v2, v2, vm1, n);
+		DivExactOddWord(v2, n, 3, INVERSE_3);
+
+		// Vm1 = (V1 - Vm1) / 2
+		if (vm1_negative)
+			AddWords(vm1, v1, vm1, n);
+		else
+			SubWords(vm1, v1, vm1, n);
+		ShiftRightWords(vm1, vm1, n, 1);
+
+		// V1 = V1 - V0
+		SubWordsFrom(v1, n, v0, 2 * k);
+
+		// V2 = (V2 - V1) / 2
+		SubWords(v2, v2, v1, n);
+		ShiftRightWords(v2, v2, n, 1);
+
+		// V1 = V1 - Vm1 - Vinf (C2)
+		SubWords(v1, v1, vm1, n);
+		SubWordsFrom(v1, n, vinf, inf_size);
+
+		// V2 = V2 - 2*Vinf (C3)
+		SubWordsFrom(v2, n, vinf, inf_size);
+		SubWordsFrom(v2, n, vinf, inf_size);
+
+		// Vm1 = Vm1 - V2 (C1)
+		SubWords(vm1, vm1, v2, n);
+
+		// Recompose (the coefficients' words beyond the product size are zero)
+		memset(r + 2 * k, 0, 2 * k * sizeof(WORD));
+		AddWordsTo(r + k, size - k, vm1, std::min(n, size - k));
+		AddWordsTo(r + 2 * k, size - 2 * k, v1, std::min(n, size - 2 * k));
+		AddWordsTo(r + 3 * k, size - 3 * k, v2, std::min(n, size - 3 * k));
+	}
+
+	/// <param name="k">The number of parts</param>
+	/// <param name="a_size">The first factor size in words</param>
+	/// <param name="b_size">The second factor size in words (less than or equal to the first one)</param>
+	/// <returns>True if the factors are long and balanced enough to be split in k non-empty parts by the Toom-Cook k-Way algorithm</returns>
+	static bool CanUseToomCook(std::size_t k, std::size_t a_size, std::size_t b_size) {
+
+		return b_size > (k - 1) * ((a_size + k - 1) / k);
+	}
+
+	/// <param name="a_size">The first factor size in words</param>
+	/// <param name="b_size">The second factor size in words (less than or equal to the first one)</param>
+	/// <returns>The number of parts of the Toom-Cook algorithm to use (the highest order whose threshold is reached), or 0 for the Karatsuba algorithm</returns>
+	static std::size_t SelectToomCook(std::size_t a_size, std::size_t b_size) {
+
+		if (b_size >= s_ToomCook8Threshold.load(std::memory_order_relaxed) && CanUseToomCook(8, a_size, b_size))
+			return 8;
+
+		if (b_size >= s_ToomCook6Threshold.load(std::memory_order_relaxed) && CanUseToomCook(6, a_size, b_size))
+			return 6;
+
+		if (b_size >= s_ToomCook4Threshold.load(std::memory_order_relaxed) && CanUseToomCook(4, a_size, b_size))
+			return 4;
+
+		if (b_size >= s_ToomCook3Threshold.load(std::memory_order_relaxed) && CanUseToomCook(3, a_size, b_size))
+			return 3;
+
+		return 0;
+	}
+
+	/// <param name="a_size">The first factor size in words</param>
+	/// <param name="b_size">The second factor size in words</param>
+	/// <param name="threads">The number of threads available for the product</param>
+	/// <returns>True if the product should be split among the threads</returns>
+	static bool UseParallel(std::size_t a_size, std::size_t b_size, std::size_t threads) {
+
+		return threads > 1 && std::min(a_size, b_size) >= s_ParallelThreshold.load(std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Bounds how many scratch words the recursive multiplication (or squaring) of two word arrays draws from the arena. A level whose longest
+	/// factor is n words long reserves R words and recurses on factors of at most c <= n / 2 + 2 words, and every algorithm keeps R + 6c within
+	/// 6n + 100 (Toom-Cook 3-Way reserves 12c and recurses on c ~ n / 3, the tightest case, Toom-Cook 8-Way has the largest constant). By
+	/// induction, the recursion below n takes at most 6n words plus 128 words for every level, where a level halves n (plus 2) and the last one
+	/// is above the lowest Karatsuba threshold. The threads' sub-products draw from arenas of their own, sized the same way
+	/// </summary>
+	/// <param name="na">The first factor size in words</param>
+	/// <param name="nb">The second factor size in words</param>
+	/// <param name="threads">The number of threads available for the product</param>
+	/// <returns>The scratch size in words</returns>
+	static std::size_t MultScratchSize(std::size_t na, std::size_t nb, std::size_t threads) {
+
+		if (!UseParallel(na, nb, threads) && (SelectTransform(na, nb) || std::min(na, nb) < s_KaratsubaThreshold.load(std::memory_order_relaxed)))
+			return 0;
+
+		const std::size_t n = std::max(na, nb);
+
+		std::size_t levels = 0;
+		for (std::size_t i = n; i >= KARATSUBA_MIN_THRESHOLD; i = i / 2 + 2)
+			levels++;
+
+		return 6 * n + 128 * levels;
+	}
+
+	static void MultRecursive(WORD* r, const WORD* a, std::size_t na, const WORD* b, std::size_t nb, ScratchArena& arena, std::size_t threads);
+	static void SquareRecursive(WORD* r, const WORD* a, std::size_t n, ScratchArena& arena, std::size_t threads);
+
+	/// <summary>
+	/// Queues the multiplication of two word arrays in a task group. The task draws its temporaries from its own scratch arena
+	/// </summary>
+	/// <param name="group">The task group</param>
+	/// <param name="r">The product (na + nb words, it must not overlap the factors)</param>
+	/// <param name="a">The first factor</param>
+	/// <param name="na">The first factor size in words</param>
+	/// <param name="b">The second factor</param>
+	/// <param name="nb">The second factor size in words</param>
+	/// <param name="threads">The number of threads available for the product</param>
+	static void RunMult(ThreadPool::TaskGroup& group, WORD* r, const WORD* a, std::size_t na, const WORD* b, std::size_t nb, std::size_t threads) {
+
+		group.Run([=]() {
+
+			ScratchArena arena(MultScratchSize(na, nb, threads));
+			MultRecursive(r, a, na, b, nb, arena, threads);
+		});
+	}
+
+	/// <summary>
+	/// Queues the squaring of a word array in a task group. The task draws its temporaries from its own scratch arena
+	/// </summary>
+	/// <param name="group">The task group</param>
+	/// <param name="r">The result (2n words, it must not overlap the source)</param>
+	/// <param name="a">The word array to square</param>
+	/// <param name="n">The array's length</param>
+	/// <param name="threads">The number of threads available for the product</param>
+	static void RunSquare(ThreadPool::TaskGroup& group, WORD* r, const WORD* a, std::size_t n, std::size_t threads) {
+
+		group.Run([=]() {
+
+			ScratchArena arena(MultScratchSize(n, n, threads));
+			SquareRecursive(r, a, n, arena, threads);
+		});
+	}
+
+	/// <summary>
+	/// Multiplies two word arrays with the Karatsuba algorithm
+	/// </summary>
+	/// <param name="r">The product (na + nb words, it must not overlap the factors)</param>
+	/// <param name="a">The first factor</param>
+	/// <param name="na">The first factor size in words</param>
+	/// <param name="b">The second factor</param>
+	/// <param name="nb">The second factor size in words (less than or equal to the first one)</param>
+	/// <param name="arena">The scratch memory arena</param>
+	/// <param name="threads">The number of threads available for the product (the sub-products run in parallel if it is greater than 1)</param>
+	static void KaratsubaMult(WORD* r, const WORD* a, std::size_t na, const WORD* b, std::size_t nb, ScratchArena& arena, std::size_t threads) {
+
+		const std::size_t m = na / 2;
+		const std::size_t h = na - m;
+		const std::size_t mark = arena.Mark();
+
+		// The second factor fits in the low part: A * B = A0 * B + A1 * B * 2^(m * W)
+		if (nb <= m) {
+
+			WORD* t = arena.Alloc(h + nb);
+
+			if (threads > 1) {
+
+				const std::size_t subThreads = (threads + 1) / 2;
+				ThreadPool::TaskGroup group(GetThreadPool());
+				RunMult(group, r, a, m, b, nb, subThreads);
+				MultRecursive(t, a + m, h, b, nb, arena, subThreads);
+				group.Wait();
+			}
+
+			else {
+
+				MultRecursive(r, a, m, b, nb, arena, 1);
+				MultRecursive(t, a + m, h, b, nb, arena, 1);
+			}
+
+			memset(r + m + nb, 0, h * sizeof(WORD));
+			AddWordsTo(r + m, h + nb, t, h + nb);
+
+			arena.Release(mark);
+
+			return;
+		}
+
+		const std::size_t hb = nb - m;
+
+		WORD* a01 = arena.Alloc(h + 1);
+		WORD* b01 = arena.Alloc(h + 1);
+		WORD* k2 = arena.Alloc(2 * h + 2);
+
+		// A01 = A0 + A1
+		bi_memcpy(a01, (h + 1) * sizeof(WORD), a + m, h * sizeof(WORD));
+		a01[h] = AddWordsTo(a01, h, a, m);
+
+		// B01 = B0 + B1
+		memset(b01, 0, (h + 1) * sizeof(WORD));
+		bi_memcpy(b01, (h + 1) * sizeof(WORD), b, m * sizeof(WORD));
+		AddWordsTo(b01, h + 1, b + m, hb);
+
+		// K3 = A0 * B0 and K1 = A1 * B1 (directly in the product), K2 = A01 * B01
+		if (threads > 1) {
+
+			const std::size_t subThreads = (threads + 2) / 3;
+			ThreadPool::TaskGroup group(GetThreadPool());
+			RunMult(group, r, a, m, b, m, subThreads);
+			RunMult(group, r + 2 * m, a + m, h, b + m, hb, subThreads);
+			MultRecursive(k2, a01, h + 1, b01, h + 1, arena, subThreads);
+			group.Wait();
+		}
+
+		else {
+
+			MultRecursive(r, a, m, b, m, arena, 1);
+			MultRecursive(r + 2 * m, a + m, h, b + m, hb, arena, 1);
+			MultRecursive(k2, a01, h + 1, b01, h + 1, arena, 1);
+		}
+
+		// K2 = K2 - K3 - K1
+		SubWordsFrom(k2, 2 * h + 2, r, 2 * m);
+		SubWordsFrom(k2, 2 * h + 2, r + 2 * m, h + hb);
+
+		AddWordsTo(r + m, na + nb - m, k2, std::min(2 * h + 2, na + nb - m));
+
+		arena.Release(mark);
+	}
+
+	/// <summary>
+	/// Multiplies two word arrays with the Toom-Cook 3-Way algorithm
+	/// </summary>
+	/// <param name="r">The product (na + nb words, it must not overlap the factors)</param>
+	/// <param name="a">The first factor</param>
+	/// <param name="na">The first factor size in words</param>
+	/// <param name="b">The second factor</param>
+	/// <param name="nb">The second factor size in words (less than or equal to the first one, but greater than 2/3 of it)</param>
+	/// <param name="arena">The scratch memory arena</param>
+	/// <param name="threads">The number of threads available for the product (the sub-products run in parallel if it is greater than 1)</param>
+	static void ToomCook3Mult(WORD* r, const WORD* a, std::size_t na, const WORD* b, std::size_t nb, ScratchArena& arena, std::size_t threads) {
+
+		const std::size_t k = (na + 2) / 3;
+		const std::size_t s = na - 2 * k;
+		const std::size_t t = nb - 2 * k;
+		const std::size_t mark = arena.Mark();
+
+		WORD* pa1 = arena.Alloc(k + 1);
+		WORD* pam1 = arena.Alloc(k + 1);
+		WORD* pa2 = arena.Alloc(k + 1);
+		WORD* pb1 = arena.Alloc(k + 1);
+		WORD* pbm1 = arena.Alloc(k + 1);
+		WORD* pb2 = arena.Alloc(k + 1);
+		WORD* v1 = arena.Alloc(2 * k + 2);
+		WORD* vm1 = arena.Alloc(2 * k + 2);
+		WORD* v2 = arena.Alloc(2 * k + 2);
+
+		// Evaluate
+		const bool negative = ToomCook3Evaluate(a, k, s, pa1, pam1, pa2) ^ ToomCook3Evaluate(b, k, t, pb1, pbm1, pb2);
+
+		// V0 and Vinf (directly in the product), V1, Vm1 and V2
+		if (threads > 1) {
+
+			const std::size_t subThreads = (threads + 4) / 5;
+			ThreadPool::TaskGroup group(GetThreadPool());
+			RunMult(group, r, a, k, b, k, subThreads);
+			RunMult(group, r + 4 * k, a + 2 * k, s, b + 2 * k, t, subThreads);
+			RunMult(group, v1, pa1, k + 1, pb1, k + 1, subThreads);
+			RunMult(group, vm1, pam1, k + 1, pbm1, k + 1, subThreads);
+			MultRecursive(v2, pa2, k + 1, pb2, k + 1, arena, subThreads);
+			group.Wait();
+		}
+
+		else {
+
+			MultRecursive(r, a, k, b, k, arena, 1);
+			MultRecursive(r + 4 * k, a + 2 * k, s, b + 2 * k, t, arena, 1);
+			MultRecursive(v1, pa1, k + 1, pb1, k + 1, arena, 1);
+			MultRecursive(vm1, pam1, k + 1, pbm1, k + 1, arena, 1);
+			MultRecursive(v2, pa2, k + 1, pb2, k + 1, arena, 1);
+		}
+
+		ToomCook3Interpolate(r, k, s + t, v1, vm1, negative, v2);
+
+		arena.Release(mark);
+	}
+
+	/// <summary>
+	/// Evaluates in x and -x the polynomial whose coefficients are the k parts of a number, splitting it in its even and odd parts:
+	/// p(x) = E + O and p(-x) = E - O
+	/// </summary>
+	/// <param name="a">The number to split (every part is m words long, except the last one, which is s words long)</param>
+	/// <param name="m">The split size in words</param>
+	/// <param name="s">The most significant part size in words (between 1 and m)</param>
+	/// <param name="k">The number of parts</param>
+	/// <param name="x">The point</param>
+	/// <param name="pp">The value in x (m + 1 words)</param>
+	/// <param name="pm">The absolute value in -x (m + 1 words)</param>
+	/// <returns>True if the value in -x is negative</returns>
+	static bool ToomCookEvaluatePair(const WORD* a, std::size_t m, std::size_t s, std::size_t k, WORD x, WORD* pp, WORD* pm) {
+
+		const std::size_t e = m + 1;
+
+		// E and O / x with Horner's method in x^2
+		for (std::size_t parity = 0; parity < 2; parity++) {
+
+			WORD* acc = parity ? pm : pp;
+			memset(acc, 0, e * sizeof(WORD));
+
+			std::size_t i = k - 1;
+			if ((i & 1) != parity)
+				i--;
+
+			for (; i < k; i -= 2) {
+
+				MultWord(acc, acc, e, x * x);
+				AddWordsTo(acc, e, a + i * m, i == k - 1 ? s : m);
+				if (i < 2)
+					break;
+			}
+		}
+
+		MultWord(pm, pm, e, x);
+
+		// P(x) = E + O and |P(-x)| = |E - O| (computed as E + O - 2O or 2O - (E + O), wrapping around on e words)
+		const bool negative = CompareWords(pp, pm, e) < 0;
+		AddWords(pp, pp, pm, e);
+		ShiftLeftWords(pm, pm, e, 1);
+		if (negative)
+			SubWords(pm, pm, pp, e);
+		else
+			SubWords(pm, pp, pm, e);
+
+		return negative;
+	}
+
+	/// <summary>
+	/// Evaluates in x the polynomial whose coefficients are the k parts of a number
+	/// </summary>
+	/// <param name="a">The number to split (every part is m words long, except the last one, which is s words long)</param>
+	/// <param name="m">The split size in words</param>
+	/// <param name="s">The most significant part size in words (between 1 and m)</param>
+	/// <param name="k">The number of parts</param>
+	/// <param name="x">The point</param>
+	/// <param name="p">The value in x (m + 1 words)</param>
+	static void ToomCookEvaluate(const WORD* a, std::size_t m, std::size_t s, std::size_t k, WORD x, WORD* p) {
+
+		const std::size_t e = m + 1;
+
+		memset(p, 0, e * sizeof(WORD));
+		bi_memcpy(p, e * sizeof(WORD), a + (k - 1) * m, s * sizeof(WORD));
+		for (std::size_t i = k - 1; i--;) {
+
+			MultWord(p, p, e, x);
+			AddWordsTo(p, e, a + i * m, m);
+		}
+	}
+
+	/// <summary>
+	/// Multiplies (or squares) two word arrays with the Toom-Cook k-Way algorithm. The product polynomial is evaluated in 0, infinity, the pairs
+	/// 1, -1, 2, -2, ..., k - 2, 2 - k and in k - 1. The values in every pair give the even and the odd coefficients in x^2, which are recovered
+	/// separately with Newton's divided differences, so every interpolation step uses a word-sized constant
+	/// </summary>
+	/// <param name="r">The product (na + nb words, it must not overlap the factors)</param>
+	/// <param name="a">The first factor</param>
+	/// <param name="na">The first factor size in words</param>
+	/// <param name="b">The second factor (nullptr to square the first one)</param>
+	/// <param name="nb">The second factor size in words (less than or equal to the first one, but long enough to have k non-empty parts)</param>
+	/// <param name="k">The number of parts (6 or 8)</param>
+	/// <param name="arena">The scratch memory arena</param>
+	static void ToomCookK(WORD* r, const WORD* a, std::size_t na, const WORD* b, std::size_t nb, std::size_t k, ScratchArena& arena) {
+
+		const std::size_t m = (na + k - 1) / k;
+		const std::size_t s = na - (k - 1) * m;
+		const std::size_t t = nb - (k - 1) * m;
+		const std::size_t e = m + 1;         // Evaluation size
+		const std::size_t w = 2 * m + 4;     // Value size (two's complement, with room for the intermediate interpolation values)
+		const std::size_t pairs = k - 2;
+		const std::size_t size = na + nb;
+		const std::size_t mark = arena.Mark();
+
+		WORD* pa = arena.Alloc(e);
+		WORD* pam = arena.Alloc(e);
+		WORD* pb = arena.Alloc(e);
+		WORD* pbm = arena.Alloc(e);
+		WORD* tmp = arena.Alloc(w);
+		WORD* even[8];
+		WORD* odd[8];
+		WORD nodes[8];
+		for (std::size_t i = 0; i < pairs; i++) {
+
+			even[i] = arena.Alloc(w);
+			odd[i] = arena.Alloc(w);
+		}
+
+		odd[pairs] = arena.Alloc(w);
+
+		// Multiplies the evaluations into a value (negating it if required)
+		auto Product = [&](WORD* v, const WORD* x, const WORD* y, bool negative) {
+
+			if (b)
+				MultRecursive(v, x, e, y, e, arena, 1);
+			else
+				SquareRecursive(v, x, e, arena, 1);
+
+			memset(v + 2 * e, 0, (w - 2 * e) * sizeof(WORD));
+			if (negative)
+				NegateWords(v, w);
+		};
+
+		// V0 and Vinf (directly in the product)
+		if (b) {
+
+			MultRecursive(r, a, m, b, m, arena, 1);
+			MultRecursive(r + (2 * k - 2) * m, a + (k - 1) * m, s, b + (k - 1) * m, t, arena, 1);
+		}
+
+		else {
+
+			SquareRecursive(r, a, m, arena, 1);
+			SquareRecursive(r + (2 * k - 2) * m, a + (k - 1) * m, s, arena, 1);
+		}
+
+		const WORD* v0 = r;
+		const WORD* vinf = r + (2 * k - 2) * m;
+		const std::size_t infSize = size - (2 * k - 2) * m;
+
+		// Values in x and -x, turned into E(x^2) = (V(x) + V(-x)) / 2 and O(x^2) = (V(x) - V(-x)) / 2x
+		for (std::size_t i = 0; i < pairs; i++) {
+
+			const WORD x = (WORD)(i + 1);
+			nodes[i] = x * x;
+
+			bool negative = ToomCookEvaluatePair(a, m, s, k, x, pa, pam);
+			if (b) {
+
+				negative ^= ToomCookEvaluatePair(b, m, t, k, x, pb, pbm);
+				Product(even[i], pa, pb, false);
+				Product(odd[i], pam, pbm, negative);
+			}
+
+			else {
+
+				Product(even[i], pa, pa, false);
+				Product(odd[i], pam, pam, false);
+			}
+
+			AddWords(tmp, even[i], odd[i], w);
+			SubWords(odd[i], even[i], odd[i], w);
+			bi_memcpy(even[i], w * sizeof(WORD), tmp, w * sizeof(WORD));
+			DivExactSignedWord(even[i], w, 2);
+			DivExactSignedWord(odd[i], w, 2 * x);
+
+			// (E(x^2) - V0 - Vinf * x^(2k - 2)) / x^2 only has the unknown even coefficients
+			SubWordsFrom(even[i], w, v0, 2 * m);
+			memset(tmp, 0, w * sizeof(WORD));
+			bi_memcpy(tmp, w * sizeof(WORD), vinf, infSize * sizeof(WORD));
+			for (std::size_t j = 1; j < k; j++)
+				MultWord(tmp, tmp, w, nodes[i]);
+			SubWords(even[i], even[i], tmp, w);
+			DivExactSignedWord(even[i], w, nodes[i]);
+		}
+
+		// The even coefficients
+		NewtonInterpolate(even, nodes, pairs, w);
+
+		// Value in k - 1, turned into O((k - 1)^2) = (V(k - 1) - E((k - 1)^2)) / (k - 1)
+		const WORD xe = (WORD)(k - 1);
+		nodes[pairs] = xe * xe;
+
+		ToomCookEvaluate(a, m, s, k, xe, pa);
+		if (b) {
+
+			ToomCookEvaluate(b, m, t, k, xe, pb);
+			Product(odd[pairs], pa, pb, false);
+		}
+
+		else {
+
+			Product(odd[pairs], pa, pa, false);
+		}
+
+		memset(tmp, 0, w * sizeof(WORD));
+		bi_memcpy(tmp, w * sizeof(WORD), vinf, infSize * sizeof(WORD));
+		for (std::size_t j = pairs; j--;) {
+
+			MultWord(tmp, tmp, w, nodes[pairs]);
+			AddWords(tmp, tmp, even[j], w);
+		}
+
+		MultWord(tmp, tmp, w, nodes[pairs]);
+		AddWordsTo(tmp, w, v0, 2 * m);
+		SubWords(odd[pairs], odd[pairs], tmp, w);
+		DivExactSignedWord(odd[pairs], w, xe);
+
+		// The odd coefficients
+		NewtonInterpolate(odd, nodes, pairs + 1, w);
+
+		// Recompose (the coefficients' words beyond the product size are zero)
+		memset(r + 2 * m, 0, (2 * k - 4) * m * sizeof(WORD));
+		for (std::size_t i = 1; i < 2 * k - 2; i++) {
+
+			const WORD* c = (i & 1) ? odd[i / 2] : even[i / 2 - 1];
+			AddWordsTo(r + i * m, size - i * m, c, std::min(w, size - i * m));
+		}
+
+		arena.Release(mark);
+	}
+
+	/// <summary>
+	/// Evaluates in 1/2 the polynomial whose coefficients are the 4 parts of a number, scaled by 8 to keep it an integer: 8*A0 + 4*A1 + 2*A2 + A3
+	/// </summary>
+	/// <param name="a">The number to split (A0, A1 and A2 are m words long, A3 is s words long)</param>
+	/// <param name="m">The split size in words</param>
+	/// <param name="s">The most significant part size in words (between 1 and m)</param>
+	/// <param name="p">The scaled value in 1/2 (m + 1 words)</param>
+	static void ToomCook4EvaluateHalf(const WORD* a, std::size_t m, std::size_t s, WORD* p) {
+
+		const std::size_t e = m + 1;
+
+		memset(p, 0, e * sizeof(WORD));
+		bi_memcpy(p, e * sizeof(WORD), a, m * sizeof(WORD));
+		for (std::size_t i = 1; i < 4; i++) {
+
+			ShiftLeftWords(p, p, e, 1);
+			AddWordsTo(p, e, a + i * m, i == 3 ? s : m);
+		}
+	}
+
+	/// <summary>
+	/// Multiplies (or squares) two word arrays with the Toom-Cook 4-Way algorithm. The product polynomial is evaluated in Bodrato's points 0, 1, -1,
+	/// 2, -2, 1/2 and infinity, and the coefficients are recovered with a fixed sequence of additions, shifts and exact divisions by 2, 3 and 5
+	/// </summary>
+	/// <param name="r">The product (na + nb words, it must not overlap the factors)</param>
+	/// <param name="a">The first factor</param>
+	/// <param name="na">The first factor size in words</param>
+	/// <param name="b">The second factor (nullptr to square the first one)</param>
+	/// <param name="nb">The second factor size in words (less than or equal to the first one, but greater than 3/4 of it)</param>
+	/// <param name="arena">The scratch memory arena</param>
+	static void ToomCook4Mult(WORD* r, const WORD* a, std::size_t na, const WORD* b, std::size_t nb, ScratchArena& arena) {
+
+		const std::size_t m = (na + 3) / 4;
+		const std::size_t s = na - 3 * m;
+		const std::size_t t = nb - 3 * m;
+		const std::size_t e = m + 1;         // Evaluation size
+		const std::size_t w = 2 * m + 4;     // Value size (two's complement, with room for the intermediate interpolation values)
+		const std::size_t size = na + nb;
+		const std::size_t mark = arena.Mark();
+
+		WORD* pa = arena.Alloc(e);
+		WORD* pam = arena.Alloc(e);
+		WORD* pb = arena.Alloc(e);
+		WORD* pbm = arena.Alloc(e);
+		WORD* v1 = arena.Alloc(w);
+		WORD* vm1 = arena.Alloc(w);
+		WORD* v2 = arena.Alloc(w);
+		WORD* vm2 = arena.Alloc(w);
+		WORD* vh = arena.Alloc(w);
+		WORD* tmp = arena.Alloc(w);
+
+		// Multiplies the evaluations into a value (negating it if required)
+		auto Product = [&](WORD* v, const WORD* x, const WORD* y, bool negative) {
+
+			if (b)
+				MultRecursive(v, x, e, y, e, arena, 1);
+			else
+				SquareRecursive(v, x, e, arena, 1);
+
+			memset(v + 2 * e, 0, (w - 2 * e) * sizeof(WORD));
+			if (negative)
+				NegateWords(v, w);
+		};
+
+		// Copies a part of the product (shorter than a value) into the temporary value, shifted to the left
+		auto Scaled = [&](const WORD* c, std::size_t n, unsigned int bits) {
+
+			tmp[n] = ShiftLeftWords(tmp, c, n, bits);
+			memset(tmp + n + 1, 0, (w - n - 1) * sizeof(WORD));
+			return tmp;
+		};
+
+		// V0 and Vinf (directly in the product)
+		if (b) {
+
+			MultRecursive(r, a, m, b, m, arena, 1);
+			MultRecursive(r + 6 * m, a + 3 * m, s, b + 3 * m, t, arena, 1);
+		}
+
+		else {
+
+			SquareRecursive(r, a, m, arena, 1);
+			SquareRecursive(r + 6 * m, a + 3 * m, s, arena, 1);
+		}
+
+		const WORD* v0 = r;
+		const WORD* vinf = r + 6 * m;
+		const std::size_t infSize = size - 6 * m;
+
+		// V1, Vm1, V2 and Vm2
+		for (WORD x = 1; x <= 2; x++) {
+
+			WORD* vp = x == 1 ? v1 : v2;
+			WORD* vm = x == 1 ? vm1 : vm2;
+
+			bool negative = ToomCookEvaluatePair(a, m, s, 4, x, pa, pam);
+			if (b) {
+
+				negative ^= ToomCookEvaluatePair(b, m, t, 4, x, pb, pbm);
+				Product(vp, pa, pb, false);
+				Product(vm, pam, pbm, negative);
+			}
+
+			else {
+
+				Product(vp, pa, pa, false);
+				Product(vm, pam, pam, false);
+			}
+		}
+
+		// Vh = 64 * V(1/2)
+		ToomCook4EvaluateHalf(a, m, s, pa);
+		if (b) {
+
+			ToomCook4EvaluateHalf(b, m, t, pb);
+			Product(vh, pa, pb, false);
+		}
+
+		else {
+
+			Product(vh, pa, pa, false);
+		}
+
+		// Vm1 = (V1 - Vm1) / 2 = C1 + C3 + C5, V1 = V1 - Vm1 = C0 + C2 + C4 + C6
+		SubWords(vm1, v1, vm1, w);
+		DivExactSignedWord(vm1, w, 2);
+		SubWords(v1, v1, vm1, w);
+
+		// Vm2 = (V2 - Vm2) / 4 = C1 + 4*C3 + 16*C5, V2 = V2 - 2*Vm2 = C0 + 4*C2 + 16*C4 + 64*C6
+		SubWords(vm2, v2, vm2, w);
+		DivExactSignedWord(vm2, w, 2);
+		SubWords(v2, v2, vm2, w);
+		DivExactSignedWord(vm2, w, 2);
+
+		// V1 = V1 - V0 - Vinf = C2 + C4
+		SubWordsFrom(v1, w, v0, 2 * m);
+		SubWordsFrom(v1, w, vinf, infSize);
+
+		// V2 = (V2 - V0 - 64*Vinf) / 4 = C2 + 4*C4
+		SubWordsFrom(v2, w, v0, 2 * m);
+		SubWords(v2, v2, Scaled(vinf, infSize, 6), w);
+		DivExactSignedWord(v2, w, 4);
+
+		// V2 = (V2 - V1) / 3 = C4, V1 = V1 - V2 = C2
+		SubWords(v2, v2, v1, w);
+		DivExactOddWord(v2, w, 3, INVERSE_3);
+		SubWords(v1, v1, v2, w);
+
+		// Vh = (Vh - 64*V0 - 16*C2 - 4*C4 - Vinf) / 2 = 16*C1 + 4*C3 + C5
+		SubWords(vh, vh, Scaled(v0, 2 * m, 6), w);
+		SubWordsFrom(vh, w, vinf, infSize);
+		ShiftLeftWords(tmp, v1, w, 2);
+		AddWords(tmp, tmp, v2, w);
+		ShiftLeftWords(tmp, tmp, w, 2);
+		SubWords(vh, vh, tmp, w);
+		DivExactSignedWord(vh, w, 2);
+
+		// Vm2 = (Vm2 - Vm1) / 3 = C3 + 5*C5
+		SubWords(vm2, vm2, vm1, w);
+		DivExactOddWord(vm2, w, 3, INVERSE_3);
+
+		// Vh = (16*Vm1 - Vh) / 3 = 4*C3 + 5*C5
+		ShiftLeftWords(tmp, vm1, w, 4);
+		SubWords(vh, tmp, vh, w);
+		DivExactOddWord(vh, w, 3, INVERSE_3);
+
+		// Vh = (Vh - Vm2) / 3 = C3 (C3)
+		SubWords(vh, vh, vm2, w);
+		DivExactOddWord(vh, w, 3, INVERSE_3);
+
+		// Vm2 = (Vm2 - Vh) / 5 = C5 (C5)
+		SubWords(vm2, vm2, vh, w);
+		DivExactOddWord(vm2, w, 5, INVERSE_5);
+
+		// Vm1 = Vm1 - Vh - Vm2 = C1 (C1)
+		SubWords(vm1, vm1, vh, w);
+		SubWords(vm1, vm1, vm2, w);
+
+		// Recompose (the coefficients' words beyond the product size are zero)
+		const WORD* c[5] = { vm1, v1, vh, v2, vm2 };
+		memset(r + 2 * m, 0, 4 * m * sizeof(WORD));
+		for (std::size_t i = 1; i < 6; i++)
+			AddWordsTo(r + i * m, size - i * m, c[i - 1], std::min(w, size - i * m));
+
+		arena.Release(mark);
+	}
+
+	/// <summary>
+	/// Multiplies two unbalanced word arrays with the Toom-Cook 2.5-Way algorithm: the first factor is split in three parts and the second one
+	/// in two, and the product polynomial is evaluated in 0, 1, -1 and infinity
+	/// </summary>
+	/// <param name="r">The product (na + nb words, it must not overlap the factors)</param>
+	/// <param name="a">The first factor</param>
+	/// <param name="na">The first factor size in words</param>
+	/// <param name="b">The second factor</param>
+	/// <param name="nb">The second factor size in words (between a third and two thirds of the first one)</param>
+	/// <param name="arena">The scratch memory arena</param>
+	static void ToomCook25Mult(WORD* r, const WORD* a, std::size_t na, const WORD* b, std::size_t nb, ScratchArena& arena) {
+
+		const std::size_t m = (na + 2) / 3;
+		const std::size_t s = na - 2 * m;
+		const std::size_t t = nb - m;
+		const std::size_t n = 2 * m + 2;
+		const std::size_t size = na + nb;
+		const std::size_t mark = arena.Mark();
+
+		WORD* pa1 = arena.Alloc(m + 1);
+		WORD* pam1 = arena.Alloc(m + 1);
+		WORD* pb1 = arena.Alloc(m + 1);
+		WORD* pbm1 = arena.Alloc(m + 1);
+		WORD* v1 = arena.Alloc(n);
+		WORD* vm1 = arena.Alloc(n);
+
+		// Evaluate
+		const bool negative = ToomCookEvaluatePair(a, m, s, 3, 1, pa1, pam1) ^ ToomCookEvaluatePair(b, m, t, 2, 1, pb1, pbm1);
+
+		// V0 and Vinf (directly in the product), V1 and Vm1
+		MultRecursive(r, a, m, b, m, arena, 1);
+		MultRecursive(r + 3 * m, a + 2 * m, s, b + m, t, arena, 1);
+		MultRecursive(v1, pa1, m + 1, pb1, m + 1, arena, 1);
+		MultRecursive(vm1, pam1, m + 1, pbm1, m + 1, arena, 1);
+
+		// V1 = (V1 + Vm1) / 2 and Vm1 = (V1 - Vm1) / 2 (computed as V1 + Vm1 - 2*Vm1)
+		if (negative)
+			SubWords(v1, v1, vm1, n);
+		else
+			AddWords(v1, v1, vm1, n);
+		ShiftLeftWords(vm1, vm1, n, 1);
+		if (negative)
+			AddWords(vm1, v1, vm1, n);
+		else
+			SubWords(vm1, v1, vm1, n);
+		ShiftRightWords(v1, v1, n, 1);
+		ShiftRightWords(vm1, vm1, n, 1);
+
+		// C2 = V1 - V0 and C1 = Vm1 - Vinf
+		SubWordsFrom(v1, n, r, 2 * m);
+		SubWordsFrom(vm1, n, r + 3 * m, s + t);
+
+		// Recompose (the coefficients' words beyond the product size are zero)
+		memset(r + 2 * m, 0, m * sizeof(WORD));
+		AddWordsTo(r + m, size - m, vm1, std::min(n, size - m));
+		AddWordsTo(r + 2 * m, size - 2 * m, v1, std::min(n, size - 2 * m));
+
+		arena.Release(mark);
+	}
+
+	/// <summary>
+	/// Multiplies two unbalanced word arrays with the Toom-Cook 3.5-Way algorithm: the first factor is split in four parts and the second one
+	/// in two, and the product polynomial is evaluated in the same points of the Toom-Cook 3-Way algorithm (0, 1, -1, 2 and infinity)
+	/// </summary>
+	/// <param name="r">The product (na + nb words, it must not overlap the factors)</param>
+	/// <param name="a">The first factor</param>
+	/// <param name="na">The first factor size in words</param>
+	/// <param name="b">The second factor</param>
+	/// <param name="nb">The second factor size in words (between a fourth and a half of the first one)</param>
+	/// <param name="arena">The scratch memory arena</param>
+	static void ToomCook35Mult(WORD* r, const WORD* a, std::size_t na, const WORD* b, std::size_t nb, ScratchArena& arena) {
+
+		const std::size_t m = (na + 3) / 4;
+		const std::size_t s = na - 3 * m;
+		const std::size_t t = nb - m;
+		const std::size_t mark = arena.Mark();
+
+		WORD* pa1 = arena.Alloc(m + 1);
+		WORD* pam1 = arena.Alloc(m + 1);
+		WORD* pa2 = arena.Alloc(m + 1);
+		WORD* pb1 = arena.Alloc(m + 1);
+		WORD* pbm1 = arena.Alloc(m + 1);
+		WORD* pb2 = arena.Alloc(m + 1);
+		WORD* v1 = arena.Alloc(2 * m + 2);
+		WORD* vm1 = arena.Alloc(2 * m + 2);
+		WORD* v2 = arena.Alloc(2 * m + 2);
+
+		// Evaluate
+		const bool negative = ToomCookEvaluatePair(a, m, s, 4, 1, pa1, pam1) ^ ToomCookEvaluatePair(b, m, t, 2, 1, pb1, pbm1);
+		ToomCookEvaluate(a, m, s, 4, 2, pa2);
+		ToomCookEvaluate(b, m, t, 2, 2, pb2);
+
+		// V0 and Vinf (directly in the product), V1, Vm1 and V2
+		MultRecursive(r, a, m, b, m, arena, 1);
+		MultRecursive(r + 4 * m, a + 3 * m, s, b + m, t, arena, 1);
+		MultRecursive(v1, pa1, m + 1, pb1, m + 1, arena, 1);
+		MultRecursive(vm1, pam1, m + 1, pbm1, m + 1, arena, 1);
+		MultRecursive(v2, pa2, m + 1, pb2, m + 1, arena, 1);
+
+		ToomCook3Interpolate(r, m, s + t, v1, vm1, negative, v2);
+
+		arena.Release(mark);
+	}
+
+	/// <summary>
+	/// Multiplies a long word array by a much shorter one, slicing the first factor in blocks as long as the second one. Every block product
+	/// is balanced, and it is accumulated in the product
+	/// </summary>
+	/// <param name="r">The product (na + nb words, it must not overlap the factors)</param>
+	/// <param name="a">The first factor</param>
+	/// <param name="na">The first factor size in words</param>
+	/// <param name="b">The second factor</param>
+	/// <param name="nb">The second factor size in words (less than the first one)</param>
+	/// <param name="arena">The scratch memory arena</param>
+	static void BlockwiseMult(WORD* r, const WORD* a, std::size_t na, const WORD* b, std::size_t nb, ScratchArena& arena) {
+
+		const std::size_t mark = arena.Mark();
+
+		WORD* t = arena.Alloc(2 * nb);
+
+		// The first block goes directly in the product
+		MultRecursive(r, a, nb, b, nb, arena, 1);
+
+		// The other ones overlap the previous block product by nb words
+		for (std::size_t i = nb; i < na; i += nb) {
+
+			const std::size_t length = std::min(nb, na - i);
+			MultRecursive(t, a + i, length, b, nb, arena, 1);
+
+			const WORD carry = AddWords(r + i, r + i, t, nb);
+			bi_memcpy(r + i + nb, length * sizeof(WORD), t + nb, length * sizeof(WORD));
+			AddWord(r + i + nb, length, carry);
+		}
+
+		arena.Release(mark);
+	}
+
+	/// <summary>
+	/// Multiplies two word arrays, choosing the algorithm from their sizes
+	/// </summary>
+	/// <param name="r">The product (na + nb words, it must not overlap the factors)</param>
+	/// <param name="a">The first factor</param>
+	/// <param name="na">The first factor size in words</param>
+	/// <param name="b">The second factor</param>
+	/// <param name="nb">The second factor size in words</param>
+	/// <param name="arena">The scratch memory arena</param>
+	/// <param name="threads">The number of threads available for the product</param>
+	static void MultRecursive(WORD* r, const WORD* a, std::size_t na, const WORD* b, std::size_t nb, ScratchArena& arena, std::size_t threads) {
+
+		if (na < nb) {
+
+			std::swap(a, b);
+			std::swap(na, nb);
+		}
+
+		// The top levels of huge products are split among the threads (even above the transform thresholds, since the sub-products are independent)
+		if (UseParallel(na, nb, threads)) {
+
+			if (CanUseToomCook(3, na, nb))
+				ToomCook3Mult(r, a, na, b, nb, arena, threads);
+			else
+				KaratsubaMult(r, a, na, b, nb, arena, threads);
+
+			return;
+		}
+
+		// Transform-based algorithms for huge factors
+		const MultKernel Transform = SelectTransform(na, nb);
+		if (Transform)
+			Transform(r, a, na, b, nb);
+
+		// The rows run over the shorter factor
+		else if (nb < s_KaratsubaThreshold.load(std::memory_order_relaxed))
+			BasecaseMult(r, b, nb, a, na);
+
+		// Unbalanced factors
+		else if (2 * na >= 7 * nb)
+			BlockwiseMult(r, a, na, b, nb, arena);
+
+		else if (2 * na >= 5 * nb)
+			ToomCook35Mult(r, a, na, b, nb, arena);
+
+		else if (2 * na >= 3 * nb)
+			ToomCook25Mult(r, a, na, b, nb, arena);
+
+		else {
+
+			const std::size_t k = SelectToomCook(na, nb);
+			if (k == 3)
+				ToomCook3Mult(r, a, na, b, nb, arena, 1);
+			else if (k == 4)
+				ToomCook4Mult(r, a, na, b, nb, arena);
+			else if (k)
+				ToomCookK(r, a, na, b, nb, k, arena);
+			else
+				KaratsubaMult(r, a, na, b, nb, arena, 1);
+		}
+	}
+
+	/// <summary>
+	/// Squares a word array with the Karatsuba algorithm
+	/// </summary>
+	/// <param name="r">The result (2n words, it must not overlap the source)</param>
+	/// <param name="a">The word array to square</param>
+	/// <param name="n">The array's length</param>
+	/// <param name="arena">The scratch memory arena</param>
+	/// <param name="threads">The number of threads available for the product (the sub-products run in parallel if it is greater than 1)</param>
+	static void KaratsubaSquare(WORD* r, const WORD* a, std::size_t n, ScratchArena& arena, std::size_t threads) {
+
+		const std::size_t m = n / 2;
+		const std::size_t h = n - m;
+		const std::size_t mark = arena.Mark();
+
+		WORD* a01 = arena.Alloc(h + 1);
+		WORD* k2 = arena.Alloc(2 * h + 2);
+
+		// A01 = A0 + A1
+		bi_memcpy(a01, (h + 1) * sizeof(WORD), a + m, h * sizeof(WORD));
+		a01[h] = AddWordsTo(a01, h, a, m);
+
+		// K3 = A0^2 and K1 = A1^2 (directly in the result), K2 = A01^2
+		if (threads > 1) {
+
+			const std::size_t subThreads = (threads + 2) / 3;
+			ThreadPool::TaskGroup group(GetThreadPool());
+			RunSquare(group, r, a, m, subThreads);
+			RunSquare(group, r + 2 * m, a + m, h, subThreads);
+			SquareRecursive(k2, a01, h + 1, arena, subThreads);
+			group.Wait();
+		}
+
+		else {
+
+			SquareRecursive(r, a, m, arena, 1);
+			SquareRecursive(r + 2 * m, a + m, h, arena, 1);
+			SquareRecursive(k2, a01, h + 1, arena, 1);
+		}
+
+		// K2 = K2 - K3 - K1
+		SubWordsFrom(k2, 2 * h + 2, r, 2 * m);
+		SubWordsFrom(k2, 2 * h + 2, r + 2 * m, 2 * h);
+
+		AddWordsTo(r + m, 2 * n - m, k2, std::min(2 * h + 2, 2 * n - m));
+
+		arena.Release(mark);
+	}
+
+	/// <summary>
+	/// Squares a word array with the Toom-Cook 3-Way algorithm
+	/// </summary>
+	/// <param name="r">The result (2n words, it must not overlap the source)</param>
+	/// <param name="a">The word array to square</param>
+	/// <param name="n">The array's length</param>
+	/// <param name="arena">The scratch memory arena</param>
+	/// <param name="threads">The number of threads available for the product (the sub-products run in parallel if it is greater than 1)</param>
+	static void ToomCook3Square(WORD* r, const WORD* a, std::size_t n, ScratchArena& arena, std::size_t threads) {
+
+		const std::size_t k = (n + 2) / 3;
+		const std::size_t s = n - 2 * k;
+		const std::size_t mark = arena.Mark();
+
+		WORD* p1 = arena.Alloc(k + 1);
+		WORD* pm1 = arena.Alloc(k + 1);
+		WORD* p2 = arena.Alloc(k + 1);
+		WORD* v1 = arena.Alloc(2 * k + 2);
+		WORD* vm1 = arena.Alloc(2 * k + 2);
+		WORD* v2 = arena.Alloc(2 * k + 2);
+
+		// Evaluate (the square in -1 is positive regardless of the sign of A0 - A1 + A2)
+		ToomCook3Evaluate(a, k, s, p1, pm1, p2);
+
+		// V0 and Vinf (directly in the result), V1, Vm1 and V2
+		if (threads > 1) {
+
+			const std::size_t subThreads = (threads + 4) / 5;
+			ThreadPool::TaskGroup group(GetThreadPool());
+			RunSquare(group, r, a, k, subThreads);
+			RunSquare(group, r + 4 * k, a + 2 * k, s, subThreads);
+			RunSquare(group, v1, p1, k + 1, subThreads);
+			RunSquare(group, vm1, pm1, k + 1, subThreads);
+			SquareRecursive(v2, p2, k + 1, arena, subThreads);
+			group.Wait();
+		}
+
+		else {
+
+			SquareRecursive(r, a, k, arena, 1);
+			SquareRecursive(r + 4 * k, a + 2 * k, s, arena, 1);
+			SquareRecursive(v1, p1, k + 1, arena, 1);
+			SquareRecursive(vm1, pm1, k + 1, arena, 1);
+			SquareRecursive(v2, p2, k + 1, arena, 1);
+		}
+
+		ToomCook3Interpolate(r, k, 2 * s, v1, vm1, false, v2);
+
+		arena.Release(mark);
+	}
+
+	/// <summary>
+	/// Squares a word array, choosing the algorithm from its size
+	/// </summary>
+	/// <param name="r">The result (2n words, it must not overlap the source)</param>
+	/// <param name="a">The word array to square</param>
+	/// <param name="n">The array's length</param>
+	/// <param name="arena">The scratch memory arena</param>
+	/// <param name="threads">The number of threads available for the product</param>
+	static void SquareRecursive(WORD* r, const WORD* a, std::size_t n, ScratchArena& arena, std::size_t threads) {
+
+		// The top levels of huge squares are split among the threads
+		if (UseParallel(n, n, threads)) {
+
+			ToomCook3Square(r, a, n, arena, threads);
+
+			return;
+		}
+
+		// Transform-based algorithms for huge numbers
+		const MultKernel Transform = SelectTransform(n, n);
+		if (Transform)
+			Transform(r, a, n, a, n);
+
+		else if (n < s_KaratsubaThreshold.load(std::memory_order_relaxed))
+			BasecaseSquare(r, a, n);
+
+		else {
+
+			const std::size_t k = SelectToomCook(n, n);
+			if (k == 3)
+				ToomCook3Square(r, a, n, arena, 1);
+			else if (k == 4)
+				ToomCook4Mult(r, a, n, nullptr, n, arena);
+			else if (k)
+				ToomCookK(r, a, n, nullptr, n, k, arena);
+			else
+				KaratsubaSquare(r, a, n, arena, 1);
+		}
+	}
+
+	void Mult(BigInt_T& first, const BigInt_T& second) {
+
+		std::size_t firstSize = CountSignificantWords(first);
+		std::size_t secondSize = CountSignificantWords(second);
+
+		// The two factors have the same magnitude (or they are the same object)
+		if (firstSize == secondSize && (&first == &second || memcmp(first.Buffer, second.Buffer, firstSize * sizeof(WORD)) == 0)) {
+
+			const bool sign = first.Sign ^ second.Sign;
+			Square(first);
+			first.Sign = sign;
+
+			return;
+		}
+
+		if (firstSize == 1 && secondSize == 1) {
+
+			// If the number is less than BI_MAX_HALFWORD, we can simply multiply the two buffers
+			if (*first.Buffer <= BI_MAX_HALFWORD &&
+				*second.Buffer <= BI_MAX_HALFWORD)
+
+			{
+
+				*first.Buffer *= *second.Buffer;
+				first.Sign = *first.Buffer == 0 ? BI_PLUS_SIGN : first.Sign ^ second.Sign;
+
+				return;
+			}
+		}
+
+		// Reserve space for result
+		Resize(first, std::max(std::max(first.Size, second.Size), firstSize + secondSize));
+
+		// If one of the factors is equal to zero, do not bother executing the algorithm
+		if ((firstSize == 1 && first.Buffer[0] == 0) || (secondSize == 1 && second.Buffer[0] == 0)) {
+
+			memset(first.Buffer, 0, first.Size * sizeof(WORD));
+		}
+
+		// A single-word factor only needs one pass over the other one, which can be done in place
+		else if (secondSize == 1) {
+
+			first.Buffer[firstSize] = MultWord(first.Buffer, first.Buffer, firstSize, second.Buffer[0]);
+		}
+
+		else if (firstSize == 1) {
+
+			BasecaseMult(first.Buffer, first.Buffer, 1, second.Buffer, secondSize);
+		}
+
+		else {
+
+			// The product overwrites the first factor, so a copy of it is kept in the arena together with all the temporaries
+			const std::size_t threads = s_ThreadCount.load(std::memory_order_relaxed);
+			ScratchArena arena(firstSize + MultScratchSize(firstSize, secondSize, threads));
+			WORD* a = arena.Alloc(firstSize);
+			bi_memcpy(a, firstSize * sizeof(WORD), first.Buffer, firstSize * sizeof(WORD));
+			memset(first.Buffer, 0, first.Size * sizeof(WORD));
+
+			// Multiply
+			MultRecursive(first.Buffer, a, firstSize, second.Buffer, secondSize, arena, threads);
+		}
+
+		// Establish sign
+		first.Sign = IsZero(first) ? BI_PLUS_SIGN : first.Sign ^ second.Sign;
+	}
+
+	void Square(BigInt_T& data) {
+
+		const std::size_t size = CountSignificantWords(data);
+
+		if (size == 1 && *data.Buffer <= BI_MAX_HALFWORD) {
+
+			*data.Buffer *= *data.Buffer;
+			data.Sign = BI_PLUS_SIGN;
+
+			return;
+		}
+
+		// Reserve space for result
+		Resize(data, std::max(data.Size, 2 * size));
+
+		// The result overwrites the source, so a copy of it is kept in the arena together with all the temporaries
+		const std::size_t threads = s_ThreadCount.load(std::memory_order_relaxed);
+		ScratchArena arena(size + MultScratchSize(size, size, threads));
+		WORD* a = arena.Alloc(size);
+		bi_memcpy(a, size * sizeof(WORD), data.Buffer, size * sizeof(WORD));
+		memset(data.Buffer, 0, data.Size * sizeof(WORD));
+
+		// Square
+		SquareRecursive(data.Buffer, a, size, arena, threads);
+
+		// A square is never negative
+		data.Sign = BI_PLUS_SIGN;
+	}
+
+	// --- Division ---
+
+	/// <summary>
+	/// Divides two word arrays with Knuth's algorithm D, updating the partial remainder in place one quotient word at a time
+	/// </summary>
+	/// <param name="q">The quotient (nu - nv words, the most significant one is returned)</param>
+	/// <param name="u">The dividend (nu words), replaced by the remainder in its nv least significant words</param>
+	/// <param name="nu">The dividend size in words (at least nv)</param>
+	/// <param name="v">The divisor (its most significant bit must be set)</param>
+	/// <param name="nv">The divisor size in words</param>
+	/// <param name="reciprocal">The reciprocal of the divisor's most significant word (see ReciprocalWord)</param>
+	/// <returns>The most significant quotient word (0 or 1)</returns>
+	static WORD BasecaseDivide(WORD* q, WORD* u, std::size_t nu, const WORD* v, std::size_t nv, WORD reciprocal) {
+
+		// D1: The top nv words of the dividend are brought below the divisor
+		const WORD qh = CompareWords(u + nu - nv, v, nv) >= 0;
+		if (qh)
+			SubWords(u + nu - nv, u + nu - nv, v, nv);
+
+		const WORD divisorHigh = v[nv - 1];
+
+		// D2-D7: Main loop
+		for (std::size_t j = nu - nv; j--;) {
+
+			// D3: Calculate q
+			WORD qhat = 0, r = 0;
+			bool rOverflow = false;
+			const WORD dividendHigh = u[j + nv];
+			const WORD dividendLow = u[j + nv - 1];
+
+			if (dividendHigh >= divisorHigh) {
+
+				qhat = BI_MAX_WORD;
+				r = dividendLow + divisorHigh;
+				rOverflow = r < dividendLow;
+			}
+
+			else
+				qhat = DivideDoubleWordPreinv(dividendHigh, dividendLow, divisorHigh, reciprocal, r);
+
+			// D3: Test and adjust qhat (once the remainder estimate overflows a word, the test cannot fail anymore)
+			while (!rOverflow && nv > 1) {
+
+				WORD prodHigh, prodLow;
+				MultUWORD(qhat, v[nv - 2], prodLow, prodHigh);
+
+				if (prodHigh < r || (prodHigh == r && prodLow <= u[j + nv - 2]))
+					break;
+
+				qhat--;
+				r += divisorHigh;
+				rOverflow = r < divisorHigh;
+			}
+
+			// D4: Multiply and subtract
+			const WORD borrow = SubMultWord(u + j, v, nv, qhat);
+			const WORD top = u[j + nv];
+			u[j + nv] = top - borrow;
+
+			// D5-D6: Test remainder and add back (qhat was one too large)
+			if (top < borrow) {
+
+				qhat--;
+				u[j + nv] += AddWords(u + j, u + j, v, nv);
+			}
+
+			q[j] = qhat;
+		}
+
+		return qh;
+	}
+
+	/// <param name="n">The divisor size in words</param>
+	/// <param name="threads">The number of threads available for the products</param>
+	/// <returns>The scratch words needed by DivideRecursive</returns>
+	static std::size_t DivScratchSize(std::size_t n, std::size_t threads) {
+
+		if (n < s_BurnikelZieglerThreshold.load(std::memory_order_relaxed))
+			return 0;
+
+		const std::size_t lo = n / 2;
+		const std::size_t hi = n - lo;
+
+		return n + std::max(MultScratchSize(hi, lo, threads), DivScratchSize(hi, threads));
+	}
+
+	/// <summary>
+	/// Divides a 2n-word array by an n-word one with the recursive Burnikel-Ziegler algorithm. The high half of the quotient is estimated dividing
+	/// by the high half of the divisor, then it is corrected subtracting its product with the low half (the same goes for the low half of the
+	/// quotient), so the work is dominated by the recursive multiplications
+	/// </summary>
+	/// <param name="q">The quotient (n words, the most significant one is returned)</param>
+	/// <param name="u">The dividend (2n words), replaced by the remainder in its n least significant words</param>
+	/// <param name="v">The divisor (its most significant bit must be set)</param>
+	/// <param name="n">The divisor size in words</param>
+	/// <param name="reciprocal">The reciprocal of the divisor's most significant word (see ReciprocalWord)</param>
+	/// <param name="arena">The scratch memory arena</param>
+	/// <param name="threads">The number of threads available for the products</param>
+	/// <returns>The most significant quotient word (0 or 1)</returns>
+	static WORD DivideRecursive(WORD* q, WORD* u, const WORD* v, std::size_t n, WORD reciprocal, ScratchArena& arena, std::size_t threads) {
+
+		if (n < s_BurnikelZieglerThreshold.load(std::memory_order_relaxed))
+			return BasecaseDivide(q, u, 2 * n, v, n, reciprocal);
+
+		const std::size_t lo = n / 2;
+		const std::size_t hi = n - lo;
+		const std::size_t mark = arena.Mark();
+
+		WORD* t = arena.Alloc(n);
+
+		// High half of the quotient
+		WORD qh = DivideRecursive(q + lo, u + 2 * lo, v + lo, hi, reciprocal, arena, threads);
+		MultRecursive(t, q + lo, hi, v, lo, arena, threads);
+		WORD borrow = SubWords(u + lo, u + lo, t, n);
+		if (qh)
+			borrow += SubWords(u + n, u + n, v, lo);
+
+		while (borrow) {
+
+			qh -= SubWord(q + lo, hi, 1);
+			borrow -= AddWords(u + lo, u + lo, v, n);
+		}
+
+		// Low half of the quotient
+		const WORD ql = DivideRecursive(q, u + hi, v + hi, lo, reciprocal, arena, threads);
+		MultRecursive(t, v, hi, q, lo, arena, threads);
+		borrow = SubWords(u, u, t, n);
+		if (ql)
+			borrow += SubWords(u + lo, u + lo, v, hi);
+
+		while (borrow) {
+
+			SubWord(q, lo, 1);
+			borrow -= AddWords(u, u, v, n);
+		}
+
+		arena.Release(mark);
+
+		return qh;
+	}
+
+	/// <summary>
+	/// Divides two word arrays with the Burnikel-Ziegler algorithm, computing the quotient in blocks as long as the divisor from the most
+	/// significant one. A short top block is left to the basecase, otherwise the dividend is padded with zero words so that every block is a
+	/// full 2n by n division
+	/// </summary>
+	/// <param name="q">The quotient (nu - nv words)</param>
+	/// <param name="u">The dividend (nu words, its top nv words must be less than the divisor), replaced by the remainder</param>
+	/// <param name="nu">The dividend size in words</param>
+	/// <param name="v">The divisor (its most significant bit must be set)</param>
+	/// <param name="nv">The divisor size in words</param>
+	/// <param name="reciprocal">The reciprocal of the divisor's most significant word (see ReciprocalWord)</param>
+	static void BurnikelZieglerDivide(WORD* q, WORD* u, std::size_t nu, const WORD* v, std::size_t nv, WORD reciprocal) {
+
+		std::size_t qn = nu - nv;
+		std::size_t rest = qn % nv;
+		if (rest < s_BurnikelZieglerThreshold.load(std::memory_order_relaxed)) {
+
+			BasecaseDivide(q + qn - rest, u + qn - rest, nv + rest, v, nv, reciprocal);
+			qn -= rest;
+			rest = 0;
+		}
+
+		const std::size_t pad = rest == 0 ? 0 : nv - rest;
+		const std::size_t blocks = (qn + pad) / nv;
+		const std::size_t threads = s_ThreadCount.load(std::memory_order_relaxed);
+
+		ScratchArena arena((pad == 0 ? 0 : qn + nv + pad + blocks * nv) + DivScratchSize(nv, threads));
+		WORD* w = u;
+		WORD* qw = q;
+		if (pad != 0) {
+
+			w = arena.Alloc(qn + nv + pad);
+			qw = arena.Alloc(blocks * nv);
+			bi_memcpy(w, (qn + nv + pad) * sizeof(WORD), u, (qn + nv) * sizeof(WORD));
+			memset(w + qn + nv, 0, pad * sizeof(WORD));
+		}
+
+		// Every block leaves its remainder on top of the next one
+		for (std::size_t b = blocks; b--;)
+			DivideRecursive(qw + b * nv, w + b * nv, v, nv, reciprocal, arena, threads);
+
+		if (pad != 0) {
+
+			bi_memcpy(q, qn * sizeof(WORD), qw, qn * sizeof(WORD));
+			bi_memcpy(u, nu * sizeof(WORD), w, nv * sizeof(WORD));
+		}
+
+		memset(u + nv, 0, (nu - nv) * sizeof(WORD));
+	}
+
+	/// <summary>
+	/// Divides a word array by a normalized word, shifting the dividend like the divisor on the fly
+	/// </summary>
+	/// <param name="q">The quotient (n words, it can be the dividend itself), or nullptr if only the remainder is needed</param>
+	/// <param name="a">The dividend</param>
+	/// <param name="n">The dividend size in words</param>
+	/// <param name="d">The normalized divisor (its most significant bit must be set)</param>
+	/// <param name="shift">The normalization shift in bits</param>
+	/// <param name="reciprocal">The reciprocal of the divisor (see ReciprocalWord)</param>
+	/// <returns>The remainder</returns>
+	static WORD DivideWord(WORD* q, const WORD* a, std::size_t n, WORD d, unsigned int shift, WORD reciprocal) {
+
+		constexpr unsigned int BITS_PER_WORD = sizeof(WORD) * 8;
+
+		WORD r = 0;
+		if (shift == 0) {
+
+			for (std::size_t i = n; i--;) {
+
+				const WORD qw = DivideDoubleWordPreinv(r, a[i], d, reciprocal, r);
+				if (q != nullptr)
+					q[i] = qw;
+			}
+		}
+
+		else {
+
+			r = a[n - 1] >> (BITS_PER_WORD - shift);
+			for (std::size_t i = n; i--;) {
+
+				const WORD low = (a[i] << shift) | (i == 0 ? 0 : a[i - 1] >> (BITS_PER_WORD - shift));
+				const WORD qw = DivideDoubleWordPreinv(r, low, d, reciprocal, r);
+				if (q != nullptr)
+					q[i] = qw;
+			}
+		}
+
+		return r >> shift;
+	}
+
+	/// <summary>
+	/// Divides a word array by a normalized one with Knuth's algorithm D, or with the Burnikel-Ziegler algorithm when both the divisor and the
+	/// quotient are long enough. The dividend is shifted like the divisor into the scratch memory, with an extra top word
+	/// </summary>
+	/// <param name="q">The quotient (nu - nv + 1 words, it can be the dividend itself), or nullptr if only the remainder is needed</param>
+	/// <param name="r">The remainder (nv words, it can be the dividend itself), or nullptr if only the quotient is needed</param>
+	/// <param name="a">The dividend</param>
+	/// <param name="nu">The dividend size in words (at least nv)</param>
+	/// <param name="v">The normalized divisor (its most significant bit must be set)</param>
+	/// <param name="nv">The divisor size in words</param>
+	/// <param name="shift">The normalization shift in bits</param>
+	/// <param name="reciprocal">The reciprocal of the divisor's most significant word (see ReciprocalWord)</param>
+	static void DivideNormalized(WORD* q, WORD* r, const WORD* a, std::size_t nu, const WORD* v, std::size_t nv, unsigned int shift, WORD reciprocal) {
+
+		const std::size_t nq = nu - nv + 1;
+		ScratchArena arena(nu + 1 + (q == nullptr ? nq : 0));
+		WORD* u = arena.Alloc(nu + 1);
+		if (shift == 0) {
+
+			bi_memcpy(u, (nu + 1) * sizeof(WORD), a, nu * sizeof(WORD));
+			u[nu] = 0;
+		}
+
+		else
+			u[nu] = ShiftLeftWords(u, a, nu, shift);
+
+		// The quotient words are needed by the algorithm even when they are not returned
+		if (q == nullptr)
+			q = arena.Alloc(nq);
+
+		memset(q, 0, nq * sizeof(WORD));
+		if (std::min(nv, nq) >= s_BurnikelZieglerThreshold.load(std::memory_order_relaxed))
+			BurnikelZieglerDivide(q, u, nu + 1, v, nv, reciprocal);
+		else
+			BasecaseDivide(q, u, nu + 1, v, nv, reciprocal);
+
+		if (r != nullptr) {
+
+			if (shift == 0)
+				bi_memcpy(r, nv * sizeof(WORD), u, nv * sizeof(WORD));
+			else
+				ShiftRightWords(r, u, nv, shift);
+		}
+	}
+
+	/// <param name="d">The divisor's most significant word (different from zero)</param>
+	/// <returns>The shift that sets its most significant bit</returns>
+	static unsigned int NormalizationShift(WORD d) {
+
+		constexpr WORD HIGH_BIT = (WORD)1 << (sizeof(WORD) * 8 - 1);
+
+		unsigned int shift = 0;
+		while (d < HIGH_BIT) {
+
+			d <<= 1;
+			shift++;
+		}
+
+		return shift;
+	}
+
+	/// <summary>
+	/// Divides two word arrays with Knuth's algorithm D, or with the Burnikel-Ziegler algorithm when both the divisor and the quotient are long
+	/// enough
+	/// </summary>
+	/// <param name="q">The quotient (nu - nv + 1 words, it can be the dividend itself), or nullptr if only the remainder is needed</param>
+	/// <param name="r">The remainder (nv words, it can be the dividend itself), or nullptr if only the quotient is needed</param>
+	/// <param name="a">The dividend</param>
+	/// <param name="nu">The dividend size in words (at least nv)</param>
+	/// <param name="b">The divisor (its most significant word cannot be zero)</param>
+	/// <param name="nv">The divisor size in words</param>
+	static void DivideWords(WORD* q, WORD* r, const WORD* a, std::size_t nu, const WORD* b, std::size_t nv) {
+
+		// D1: Normalize
+		const unsigned int shift = NormalizationShift(b[nv - 1]);
+
+		if (nv == 1) {
+
+			const WORD d = b[0] << shift;
+			const WORD remainder = DivideWord(q, a, nu, d, shift, ReciprocalWord(d));
+			if (r != nullptr)
+				r[0] = remainder;
+		}
+
+		else {
+
+			ScratchArena arena(nv);
+			WORD* v = arena.Alloc(nv);
+			if (shift == 0)
+				bi_memcpy(v, nv * sizeof(WORD), b, nv * sizeof(WORD));
+			else
+				ShiftLeftWords(v, b, nv, shift);
+
+			// Every quotient word is estimated dividing by the same normalized word, so its reciprocal is computed once
+			const WORD reciprocal = ReciprocalWord(v[nv - 1]);
+
+			// D2-D7
+			DivideNormalized(q, r, a, nu, v, nv, shift, reciprocal);
+		}
+	}
+
+	/// <summary>
+	/// Divides two magnitudes with Knuth's algorithm D, or with the Burnikel-Ziegler algorithm when both the divisor and the quotient are long
+	/// enough. The quotient is stored in the first one
+	/// </summary>
+	/// <param name="first">The dividend (greater than the divisor), where the quotient will be stored</param>
+	/// <param name="second">The divisor</param>
+	/// <param name="remainder">The division remainder (nullptr if not needed)</param>
+	static void DivideDirect(BigInt_T& first, const BigInt_T& second, BigInt_T* remainder) {
+
+		const std::size_t nu = CountSignificantWords(first);
+		const std::size_t nv = CountSignificantWords(second);
+
+		WORD* r = nullptr;
+		if (remainder != nullptr) {
+
+			if (remainder->Size != nv)
+				Resize(*remainder, nv);
+			r = remainder->Buffer;
+			remainder->Sign = first.Sign;
+		}
+
+		DivideWords(first.Buffer, r, first.Buffer, nu, second.Buffer, nv);
+		memset(first.Buffer + nu - nv + 1, 0, (first.Size - (nu - nv + 1)) * sizeof(WORD));
+	}
+
+	// --- Newton's method ---
+
+	// The bits kept below the precision of a truncated divisor, so that the truncation costs less than one unit of the reciprocal
+	constexpr std::size_t NEWTON_GUARD_BITS = 8;
+
+	/// <summary>
+	/// Copies the value of a big integer, clearing the words of the destination above it
+	/// </summary>
+	/// <param name="dest">The destination big integer</param>
+	/// <param name="src">The source big integer</param>
+	static void CopyValue(BigInt_T& dest, const BigInt_T& src) {
+
+		const std::size_t size = CountSignificantWords(src);
+		if (dest.Size < size)
+			Resize(dest, size);
+
+		memset(dest.Buffer, 0, dest.Size * sizeof(WORD));
+		bi_memcpy(dest.Buffer, dest.Size * sizeof(WORD), src.Buffer, size * sizeof(WORD));
+		dest.Sign = src.Sign;
+	}
+
+	/// <param name="data">The big integer set to 2^exponent</param>
+	/// <param name="exponent">The exponent</param>
+	static void SetPowerOfTwo(BigInt_T& data, std::size_t exponent) {
+
+		constexpr std::size_t BITS_PER_WORD = sizeof(WORD) * 8;
+
+		Resize(data, exponent / BITS_PER_WORD + 1);
+		memset(data.Buffer, 0, data.Size * sizeof(WORD));
+		data.Buffer[exponent / BITS_PER_WORD] = (WORD)1 << (exponent % BITS_PER_WORD);
+		data.Sign = BI_PLUS_SIGN;
+	}
+
+	/// <summary>
+	/// Approximates 2^k / n from below with Newton's method. A reciprocal with about half the precision is computed from the top bits of the
+	/// divisor (rounded up, so that it stays below the exact value too), then it is refined with r = r + r * (2^k - n * r) / 2^k, which doubles
+	/// the correct bits. All the steps are products, so the cost is a small multiple of one multiplication
+	/// </summary>
+	/// <param name="result">The reciprocal, at most a few units below the exact one</param>
+	/// <param name="n">The positive divisor</param>
+	/// <param name="k">The fixed-point precision in bits (at least as many as the divisor's bits)</param>
+	static void ApproximateReciprocal(BigInt_T& result, const BigInt_T& n, std::size_t k) {
+
+		constexpr std::size_t BITS_PER_WORD = sizeof(WORD) * 8;
+
+		const std::size_t b = CountSignificantBits(n);
+		const std::size_t p = k - b;
+
+		// The bits of a divisor much longer than the reciprocal cannot change it, so they are dropped
+		if (b > p + NEWTON_GUARD_BITS + 1) {
+
+			const std::size_t shift = b - p - NEWTON_GUARD_BITS;
+			BigInt_T top = n;
+			ShiftRight(top, shift);
+			Increment(top);
+
+			// Top bits that are all ones carry into a power of two, 2^(b - shift), whose reciprocal 2^p is exact (and it is less than one
+			// unit below 2^k / n, since the dropped bits are a 2^-(p + NEWTON_GUARD_BITS) fraction of n)
+			if (CountSignificantBits(top) > b - shift) {
+
+				SetPowerOfTwo(result, p);
+				return;
+			}
+
+			ApproximateReciprocal(result, top, k - shift);
+
+			return;
+		}
+
+		// Short reciprocals are computed with a plain division
+		if (p < s_NewtonThreshold.load(std::memory_order_relaxed) * BITS_PER_WORD) {
+
+			SetPowerOfTwo(result, k);
+			DivideDirect(result, n, nullptr);
+
+			return;
+		}
+
+		// Half precision reciprocal: rh ~ 2^(b + l) / n
+		const std::size_t l = p / 2 + NEWTON_GUARD_BITS;
+		const std::size_t shift = b > l + NEWTON_GUARD_BITS ? b - l - NEWTON_GUARD_BITS : 0;
+		BigInt_T top = n;
+		if (shift != 0) {
+
+			ShiftRight(top, shift);
+			Increment(top);
+		}
+
+		BigInt_T rh;
+		ApproximateReciprocal(rh, top, b + l - shift);
+
+		// e = 2^(b + l) - n * rh, that is 2^k - n * r scaled down by 2^(p - l), where r = rh * 2^(p - l)
+		BigInt_T e;
+		SetPowerOfTwo(e, b + l);
+		BigInt_T product = n;
+		Mult(product, rh);
+		SubU(e, product);
+
+		// r * e / 2^k only needs the top bits of e
+		const std::size_t low = b + l > p + 1 ? b + l - p - 1 : 0;
+		ShiftRight(e, low);
+		Mult(e, rh);
+		ShiftRight(e, b + 2 * l - p - low);
+
+		CopyValue(result, rh);
+		ShiftLeft(result, p - l);
+		AddU(result, e);
+	}
+
+	/// <param name="result">2^k / n, rounded toward zero</param>
+	/// <param name="n">The positive divisor</param>
+	/// <param name="k">The fixed-point precision in bits (at least as many as the divisor's bits)</param>
+	static void ExactReciprocal(BigInt_T& result, const BigInt_T& n, std::size_t k) {
+
+		ApproximateReciprocal(result, n, k);
+
+		// The approximation is below the exact value, so the remainder 2^k - n * result is positive
+		BigInt_T e;
+		SetPowerOfTwo(e, k);
+		BigInt_T product = n;
+		Mult(product, result);
+		SubU(e, product);
+
+		while (CompareU(e, n) >= 0) {
+
+			SubU(e, n);
+			Increment(result);
+		}
+	}
+
+	// A reciprocal kept for the next divisions by the same divisor (a precision of 0 means that the divisor has been seen only once)
+	struct CachedReciprocal {
+
+		BigInt_T Divisor;
+		BigInt_T Value;
+		std::size_t Precision = 0;
+		std::size_t LastUse = 0;
+	};
+
+	// The last reciprocals, replaced from the least recently used one
+	static std::vector<CachedReciprocal> s_ReciprocalCache(BI_RECIPROCAL_CACHE_SIZE);
+	static std::size_t s_ReciprocalCacheClock = 0;
+	static std::mutex s_ReciprocalCacheMutex;
+
+	void SetReciprocalCacheSize(std::size_t entries) {
+
+		std::lock_guard<std::mutex> lock(s_ReciprocalCacheMutex);
+		s_ReciprocalCache.clear();
+		s_ReciprocalCache.shrink_to_fit();
+		s_ReciprocalCache.resize(entries);
+	}
+
+	std::size_t GetReciprocalCacheSize() {
+
+		std::lock_guard<std::mutex> lock(s_ReciprocalCacheMutex);
+		return s_ReciprocalCache.size();
+	}
+
+	/// <summary>
+	/// Computes 2^k / n rounded toward zero, reusing a cached reciprocal of the same divisor when possible. A reciprocal with a higher precision
+	/// is exact at the lower one too, since floor(floor(2^j / n) / 2^(j - k)) = floor(2^k / n)
+	/// </summary>
+	/// <param name="result">2^k / n, rounded toward zero</param>
+	/// <param name="n">The positive divisor</param>
+	/// <param name="k">The fixed-point precision in bits (at least as many as the divisor's bits)</param>
+	static void ReciprocalOf(BigInt_T& result, const BigInt_T& n, std::size_t k) {
+
+		{
+			std::lock_guard<std::mutex> lock(s_ReciprocalCacheMutex);
+			for (CachedReciprocal& entry : s_ReciprocalCache) {
+
+				if (entry.Precision >= k && CompareU(entry.Divisor, n) == 0) {
+
+					entry.LastUse = ++s_ReciprocalCacheClock;
+					CopyValue(result, entry.Value);
+					ShiftRight(result, entry.Precision - k);
+
+					return;
+				}
+			}
+		}
+
+		ExactReciprocal(result, n, k);
+
+		std::lock_guard<std::mutex> lock(s_ReciprocalCacheMutex);
+		if (s_ReciprocalCache.empty())
+			return;
+
+		// A less precise reciprocal of the same divisor is replaced, otherwise the least recently used one
+		CachedReciprocal* slot = &s_ReciprocalCache[0];
+		for (CachedReciprocal& entry : s_ReciprocalCache) {
+
+			if (CompareU(entry.Divisor, n) == 0) {
+
+				slot = &entry;
+				break;
+			}
+
+			if (entry.LastUse < slot->LastUse)
+				slot = &entry;
+		}
+
+		CopyValue(slot->Divisor, n);
+		CopyValue(slot->Value, result);
+		slot->Precision = k;
+		slot->LastUse = ++s_ReciprocalCacheClock;
+	}
+
+	/// <summary>
+	/// Checks if a divisor has already been used by a division, recording it otherwise. Computing a reciprocal costs more than a division, so
+	/// it is worth it only for divisors that come back
+	/// </summary>
+	/// <param name="n">The divisor</param>
+	/// <returns>True if the divisor is in the reciprocal cache</returns>
+	static bool IsDivisorRepeated(const BigInt_T& n) {
+
+		std::lock_guard<std::mutex> lock(s_ReciprocalCacheMutex);
+		if (s_ReciprocalCache.empty())
+			return false;
+
+		CachedReciprocal* slot = &s_ReciprocalCache[0];
+		for (CachedReciprocal& entry : s_ReciprocalCache) {
+
+			if (CompareU(entry.Divisor, n) == 0) {
+
+				entry.LastUse = ++s_ReciprocalCacheClock;
+				return true;
+			}
+
+			if (entry.LastUse < slot->LastUse)
+				slot = &entry;
+		}
+
+		CopyValue(slot->Divisor, n);
+		slot->Divisor.Sign = BI_PLUS_SIGN;
+		Clear(slot->Value);
+		slot->Precision = 0;
+		slot->LastUse = ++s_ReciprocalCacheClock;
+
+		return false;
+	}
+
+	/// <param name="nu">The dividend size in words</param>
+	/// <param name="nv">The divisor size in words</param>
+	/// <returns>The quotient block size in words for the division by the reciprocal</returns>
+	static std::size_t ReciprocalBlockSize(std::size_t nu, std::size_t nv) {
+
+		return std::min(nv, nu - nv + 1);
+	}
+
+	/// <summary>
+	/// Divides two magnitudes multiplying by the reciprocal of the divisor. The quotient is computed in blocks as long as the divisor (or as the
+	/// whole quotient, if it is shorter) from the most significant one, all with the same reciprocal: every block is estimated with one product
+	/// by the reciprocal, at most three units below the exact one, and corrected with the product by the divisor
+	/// </summary>
+	/// <param name="first">The dividend (greater than the divisor), where the quotient will be stored</param>
+	/// <param name="v">The divisor (only its magnitude is used)</param>
+	/// <param name="reciprocal">2^precision / |v|, rounded toward zero</param>
+	/// <param name="precision">The reciprocal precision in bits (at least the divisor's bits plus the block bits, see ReciprocalBlockSize)</param>
+	/// <param name="remainder">The division remainder (nullptr if not needed)</param>
+	static void ReciprocalDivide(BigInt_T& first, const BigInt_T& v, const BigInt_T& reciprocal, std::size_t precision, BigInt_T* remainder) {
+
+		constexpr std::size_t BITS_PER_WORD = sizeof(WORD) * 8;
+
+		const std::size_t nu = CountSignificantWords(first);
+		const std::size_t nv = CountSignificantWords(v);
+		const std::size_t b = CountSignificantBits(v);
+
+		// Every partial dividend is below v * 2^(block words), so k = b + block bits is enough precision (a more precise reciprocal is
+		// shifted down, which keeps it exact)
+		const std::size_t block = ReciprocalBlockSize(nu, nv);
+		const std::size_t k = b + block * BITS_PER_WORD;
+		BigInt_T shifted;
+		const BigInt_T* r = &reciprocal;
+		if (precision > k) {
+
+			CopyValue(shifted, reciprocal);
+			ShiftRight(shifted, precision - k);
+			r = &shifted;
+		}
+
+		// The words above the blocks are fewer than the divisor's, so they are the first partial remainder
+		const std::size_t blocks = (nu - nv + block) / block;
+		const std::size_t top = nu - blocks * block;
+
+		BigInt_T rem;
+		Resize(rem, nv + block);
+		bi_memcpy(rem.Buffer, rem.Size * sizeof(WORD), first.Buffer + blocks * block, top * sizeof(WORD));
+
+		BigInt_T num;
+		Resize(num, nv + block);
+		for (std::size_t i = blocks; i--;) {
+
+			// num = rem * 2^(block words) + the next block of the dividend
+			memset(num.Buffer, 0, num.Size * sizeof(WORD));
+			bi_memcpy(num.Buffer, num.Size * sizeof(WORD), first.Buffer + i * block, block * sizeof(WORD));
+			bi_memcpy(num.Buffer + block, (num.Size - block) * sizeof(WORD), rem.Buffer, nv * sizeof(WORD));
+
+			// q = ((num >> (b - 2)) * reciprocal) >> (k - b + 2)
+			BigInt_T q = num;
+			ShiftRight(q, b - 2);
+			Mult(q, *r);
+			ShiftRight(q, k - b + 2);
+
+			// rem = num - q * v
+			BigInt_T product = q;
+			Mult(product, v);
+			SubU(num, product);
+			while (CompareU(num, v) >= 0) {
+
+				SubU(num, v);
+				Increment(q);
+			}
+
+			// The block has been read, so its quotient can take its place
+			bi_memcpy(first.Buffer + i * block, block * sizeof(WORD), q.Buffer, std::min(q.Size, block) * sizeof(WORD));
+			if (q.Size < block)
+				memset(first.Buffer + i * block + q.Size, 0, (block - q.Size) * sizeof(WORD));
+
+			bi_memcpy(rem.Buffer, rem.Size * sizeof(WORD), num.Buffer, nv * sizeof(WORD));
+		}
+
+		memset(first.Buffer + blocks * block, 0, (first.Size - blocks * block) * sizeof(WORD));
+
+		if (remainder != nullptr) {
+
+			rem.Sign = first.Sign;
+			CopyValue(*remainder, rem);
+		}
+	}
+
+	/// <summary>
+	/// Divides two magnitudes with ReciprocalDivide, computing the reciprocal of the divisor or taking it from the reciprocal cache
+	/// </summary>
+	/// <param name="first">The dividend (greater than the divisor), where the quotient will be stored</param>
+	/// <param name="second">The divisor</param>
+	/// <param name="remainder">The division remainder (nullptr if not needed)</param>
+	static void NewtonDivide(BigInt_T& first, const BigInt_T& second, BigInt_T* remainder) {
+
+		constexpr std::size_t BITS_PER_WORD = sizeof(WORD) * 8;
+
+		BigInt_T v = second;
+		v.Sign = BI_PLUS_SIGN;
+
+		const std::size_t block = ReciprocalBlockSize(CountSignificantWords(first), CountSignificantWords(v));
+		const std::size_t k = CountSignificantBits(v) + block * BITS_PER_WORD;
+		BigInt_T reciprocal;
+		ReciprocalOf(reciprocal, v, k);
+
+		ReciprocalDivide(first, v, reciprocal, k, remainder);
+	}
+
+	void Reciprocal(BigInt_T& data, std::size_t precision_bits) {
+
+		if (IsZero(data))
+			throw std::invalid_argument("Division by zero");
+
+		const bool sign = data.Sign;
+		data.Sign = BI_PLUS_SIGN;
+
+		// A divisor longer than the precision leaves nothing above the point, unless it is 2^precision_bits itself
+		if (CountSignificantBits(data) > precision_bits) {
+
+			BigInt_T power;
+			SetPowerOfTwo(power, precision_bits);
+			const bool one = CompareU(data, power) == 0;
+			memset(data.Buffer, 0, data.Size * sizeof(WORD));
+			data.Buffer[0] = one;
+		}
+
+		else {
+
+			BigInt_T result;
+			ReciprocalOf(result, data, precision_bits);
+			CopyValue(data, result);
+		}
+
+		data.Sign = sign;
+	}
 
 	void Div(BigInt_T& first, const BigInt_T& second, BigInt_T* remainder) {
 
-		// Divide a double word by a word
-		static std::function<WORD(WORD, WORD, WORD, WORD*)> DivideDoubleWordByWord
-		=
-		[](WORD dividend_high, WORD dividend_low, WORD divisor, WORD* remainder) {
+		if (IsZero(second))
+			throw std::invalid_argument("Division by zero");
+
+		int cmp = CompareU(first, second);
+		if (cmp < 0) {
+
+			if (remainder != nullptr) {
+
+				Resize(*remainder, CountSignificantWords(first));
+				Copy(*remainder, first);
+			}
+
+			memset(first.Buffer, 0, first.Size * sizeof(WORD));
+		}
+
+		else if (cmp == 0) {
 
-			constexpr WORD WORD_BIT_SIZE_MINUS_ONE = sizeof(WORD) * 8 - 1;
+			if (remainder != nullptr) {
 
-			std::function<int(WORD, WORD, WORD, WORD)> CompareDoubleWord
-			=
-			[](WORD a_high, WORD a_low, WORD b_high, WORD b_low) {
+				Resize(*remainder, 1);
+				remainder->Buffer[0] = 0;
+			}
 
-				if (a_high < b_high) return -1;
-				if (a_high > b_high) return 1;
-				if (a_low < b_low) return -1;
-				if (a_low > b_low) return 1;
+			memset(first.Buffer, 0, first.Size * sizeof(WORD));
+			first.Buffer[0] = 1;
+		}
 
-				return 0;
-			};
+		// Huge divisions by a divisor that comes back multiply by its reciprocal
+		else if (std::min(CountSignificantWords(second), CountSignificantWords(first) - CountSignificantWords(second)) >= s_NewtonThreshold.load(std::memory_order_relaxed) && IsDivisorRepeated(second))
+			NewtonDivide(first, second, remainder);
 
-			std::function<void(WORD, WORD, WORD, WORD, WORD&, WORD&)> SubDoubleWord
-			=
-			[](WORD a_high, WORD a_low, WORD b_high, WORD b_low, WORD& result_high, WORD& result_low) {
+		else
+			DivideDirect(first, second, remainder);
 
-				result_low = a_low - b_low;
-				result_high = a_high - b_high;
+		// Establish sign
+		first.Sign = IsZero(first) ? BI_PLUS_SIGN : first.Sign ^ second.Sign;
+	}
 
-				if (a_low < b_low)
-					--result_high;
+	void Mod(BigInt_T& first, const BigInt_T& second) {
 
-				return (a_high < b_high) || (a_high == b_high && a_low < b_low);
-			};
+		if (IsZero(second))
+			throw std::invalid_argument("Division by zero");
 
-			std::function<void(WORD&, WORD&)> ShiftLeft1DoubleWord
-			=
-			[&WORD_BIT_SIZE_MINUS_ONE](WORD& high, WORD& low) {
+		const int cmp = CompareU(first, second);
+		if (cmp < 0)
+			return;
 
-				high = (high << 1) | (low >> WORD_BIT_SIZE_MINUS_ONE);
-				low = low << 1;
-			};
+		const std::size_t nu = CountSignificantWords(first);
+		const std::size_t nv = CountSignificantWords(second);
+		const bool sign = first.Sign;
 
-			// Actual division
+		if (cmp == 0)
+			memset(first.Buffer, 0, first.Size * sizeof(WORD));
 
-#ifdef BI_DEBUG
+		// Newton's method computes the remainder from the quotient, so it cannot skip it
+		else if (std::min(nv, nu - nv) >= s_NewtonThreshold.load(std::memory_order_relaxed) && IsDivisorRepeated(second)) {
 
-			// Division by zero
-			if (divisor == 0)
-				throw std::runtime_error("Division by zero");
+			BigInt_T remainder;
+			NewtonDivide(first, second, &remainder);
+			CopyValue(first, remainder);
+		}
 
-			// Debug purposes
-			if (dividend_high >= divisor)
-				throw std::runtime_error("Quotient overflow - result would exceed 64 bits");
-#endif
+		// The quotient words are never stored (the long division keeps them in the scratch memory), and the remainder overwrites the dividend
+		else {
 
-			// Simple case
-			if (dividend_high == 0) {
+			DivideWords(nullptr, first.Buffer, first.Buffer, nu, second.Buffer, nv);
+			memset(first.Buffer + nv, 0, (first.Size - nv) * sizeof(WORD));
+		}
 
-				if (remainder)
-					*remainder = dividend_low % divisor;
+		// Establish sign
+		first.Sign = IsZero(first) ? BI_PLUS_SIGN : sign;
+	}
 
-				return dividend_low / divisor;
-			}
+	void RoundDivision(BigInt_T* quotient, BigInt_T& remainder, const BigInt_T& divisor, int rounding) {
 
-			WORD quotient = 0;
-			WORD rem_high = 0;
-			WORD rem_low = 0;
+		if (rounding != BI_ROUND_TRUNC && rounding != BI_ROUND_FLOOR && rounding != BI_ROUND_CEIL)
+			throw std::invalid_argument("Invalid rounding mode");
 
-			// Process each bit of the dividend from most significant to least significant
-			for (std::size_t j = 0; j <= WORD_BIT_SIZE_MINUS_ONE; j++) {
+		if (quotient != nullptr && IsZero(*quotient))
+			quotient->Sign = BI_PLUS_SIGN;
 
-				const std::size_t i = WORD_BIT_SIZE_MINUS_ONE - j;
+		if (IsZero(remainder)) {
 
-				ShiftLeft1DoubleWord(rem_high, rem_low);
+			remainder.Sign = BI_PLUS_SIGN;
+			return;
+		}
 
-				if (dividend_high & ((WORD)1 << (WORD)i))
-					rem_low |= 1;
+		// The truncated quotient is rounded down when it is negative (the remainder and the divisor have different signs) and up when it is
+		// positive, so in both cases its magnitude grows by one and the remainder becomes |divisor| - |remainder|
+		const bool negative = remainder.Sign != divisor.Sign;
+		if (rounding == BI_ROUND_TRUNC || (rounding == BI_ROUND_FLOOR) != negative)
+			return;
 
-				if (CompareDoubleWord(rem_high, rem_low, 0, divisor) >= 0) {
+		if (quotient != nullptr) {
 
-					WORD temp_high = 0, temp_low = 0;
-					SubDoubleWord(rem_high, rem_low, 0, divisor, temp_high, temp_low);
-					rem_high = temp_high;
-					rem_low = temp_low;
-					quotient |= ((WORD)1 << (WORD)i);
-				}
-			}
+			quotient->Sign = BI_PLUS_SIGN;
+			Increment(*quotient);
+			quotient->Sign = negative ? BI_MINUS_SIGN : BI_PLUS_SIGN;
+		}
 
-			// Process the low part of the dividend
-			for (int i = WORD_BIT_SIZE_MINUS_ONE; i >= 0; i--) {
+		BigInt_T complement = divisor;
+		SubU(complement, remainder);
+		CopyValue(remainder, complement);
+		remainder.Sign = negative ? divisor.Sign : !divisor.Sign;
+	}
 
-				ShiftLeft1DoubleWord(rem_high, rem_low);
+	/// <param name="n">The native unsigned integer</param>
+	/// <returns>True if it does not fit in a word (only on the systems with 32-bit words)</returns>
+	static bool IsWiderThanWord(std::uint64_t n) {
 
-				if (dividend_low & ((WORD)1 << (WORD)i))
-					rem_low |= 1;
+		return sizeof(WORD) < sizeof(std::uint64_t) && (n >> (sizeof(WORD) * 8 - 1) >> 1) != 0;
+	}
 
-				if (CompareDoubleWord(rem_high, rem_low, 0, divisor) >= 0) {
+	/// <summary>
+	/// Divides a big integer by a native unsigned integer wider than a word with the general division
+	/// </summary>
+	/// <param name="data">The dividend, where the quotient will be stored</param>
+	/// <param name="divisor">The divisor</param>
+	/// <param name="quotient">True to store the quotient, false to store the remainder instead</param>
+	/// <returns>The remainder's magnitude</returns>
+	static std::uint64_t DivWide(BigInt_T& data, std::uint64_t divisor, bool quotient) {
+
+		constexpr std::size_t WORDS = sizeof(std::uint64_t) / sizeof(WORD);
+
+		BigInt_T d;
+		Resize(d, WORDS);
+		for (std::size_t i = 0; i < WORDS; i++)
+			d.Buffer[i] = (WORD)(divisor >> (i * sizeof(WORD) * 8));
+
+		BigInt_T remainder;
+		if (quotient)
+			Div(data, d, &remainder);
+		else {
 
-					WORD temp_high = 0, temp_low = 0;
-					SubDoubleWord(rem_high, rem_low, 0, divisor, temp_high, temp_low);
-					rem_high = temp_high;
-					rem_low = temp_low;
-					quotient = (quotient << (WORD)1) | (WORD)1;
-				}
+			Mod(data, d);
+			remainder = data;
+		}
 
-				else
-					quotient = quotient << 1;
-			}
+		std::uint64_t r = 0;
+		for (std::size_t i = std::min(WORDS, remainder.Size); i--;)
+			r = (r << (sizeof(WORD) * 4) << (sizeof(WORD) * 4)) | remainder.Buffer[i];
 
-			if (remainder)
-				*remainder = rem_low;
+		return r;
+	}
 
-			return quotient;
-		};
+	std::uint64_t DivWord(BigInt_T& data, std::uint64_t divisor) {
 
-		constexpr WORD BASE = BI_MAX_WORD;
-		constexpr WORD BITS_PER_WORD = sizeof(WORD) * 8;
+		if (divisor == 0)
+			throw std::invalid_argument("Division by zero");
 
-		if (IsZero(second))
+		if (IsWiderThanWord(divisor))
+			return DivWide(data, divisor, true);
+
+		const WORD d = (WORD)divisor;
+		const std::size_t n = CountSignificantWords(data);
+		if (n == 1) {
+
+			const WORD r = data.Buffer[0] % d;
+			data.Buffer[0] /= d;
+
+			return r;
+		}
+
+		// The reciprocal costs about one hardware division, and it turns every other one into two multiplications
+		const unsigned int shift = NormalizationShift(d);
+		const WORD normalized = d << shift;
+
+		return DivideWord(data.Buffer, data.Buffer, n, normalized, shift, ReciprocalWord(normalized));
+	}
+
+	std::uint64_t ModWord(const BigInt_T& data, std::uint64_t divisor, BigInt_T* remainder) {
+
+		constexpr std::size_t WORDS = sizeof(std::uint64_t) / sizeof(WORD);
+
+		if (divisor == 0)
 			throw std::invalid_argument("Division by zero");
 
-		int cmp = CompareU(first, second);
-		if (cmp < 0) {
+		std::uint64_t r;
+		if (IsWiderThanWord(divisor)) {
 
-			if (remainder != nullptr) {
+			BigInt_T num = data;
+			r = DivWide(num, divisor, false);
+		}
 
-				Resize(*remainder, CountSignificantWords(first));
-				Copy(*remainder, first);
+		else {
+
+			const WORD d = (WORD)divisor;
+			const std::size_t n = CountSignificantWords(data);
+			if (n == 1)
+				r = data.Buffer[0] % d;
+
+			else {
+
+				const unsigned int shift = NormalizationShift(d);
+				const WORD normalized = d << shift;
+				r = DivideWord(nullptr, data.Buffer, n, normalized, shift, ReciprocalWord(normalized));
 			}
+		}
+
+		if (remainder != nullptr) {
+
+			const bool sign = data.Sign;
+			if (remainder->Size < WORDS)
+				Resize(*remainder, WORDS);
+
+			memset(remainder->Buffer, 0, remainder->Size * sizeof(WORD));
+			for (std::size_t i = 0; i < WORDS; i++)
+				remainder->Buffer[i] = (WORD)(r >> (i * sizeof(WORD) * 4) >> (i * sizeof(WORD) * 4));
+
+			// Establish sign
+			remainder->Sign = r == 0 ? BI_PLUS_SIGN : sign;
+		}
+
+		return r;
+	}
+
+	void PrepareDivisor(Divisor_T& divisor, const BigInt_T& value) {
+
+		constexpr std::size_t BITS_PER_WORD = sizeof(WORD) * 8;
+
+		if (IsZero(value))
+			throw std::invalid_argument("Division by zero");
+
+		CopyValue(divisor.Value, value);
+		CopyValue(divisor.Normalized, value);
+		divisor.Normalized.Sign = BI_PLUS_SIGN;
+
+		const std::size_t n = CountSignificantWords(divisor.Normalized);
+
+		// Normalize
+		divisor.Shift = NormalizationShift(divisor.Normalized.Buffer[n - 1]);
+		if (divisor.Shift != 0)
+			ShiftLeftWords(divisor.Normalized.Buffer, divisor.Normalized.Buffer, n, (unsigned int)divisor.Shift);
+
+		divisor.WordReciprocal = ReciprocalWord(divisor.Normalized.Buffer[n - 1]);
+
+		// The Barrett reciprocal is as precise as the longest block of ReciprocalDivide needs, and it pays off only where Newton's method does
+		Clear(divisor.Reciprocal);
+		divisor.Precision = 0;
+		if (n >= s_NewtonThreshold.load(std::memory_order_relaxed)) {
+
+			BigInt_T v = divisor.Value;
+			v.Sign = BI_PLUS_SIGN;
+			divisor.Precision = CountSignificantBits(v) + n * BITS_PER_WORD;
+			ExactReciprocal(divisor.Reciprocal, v, divisor.Precision);
+		}
+	}
+
+	void Div(BigInt_T& first, const Divisor_T& second, BigInt_T* remainder) {
+
+		const std::size_t nu = CountSignificantWords(first);
+		const std::size_t nv = CountSignificantWords(second.Normalized);
+		const unsigned int shift = (unsigned int)second.Shift;
+		const bool sign = first.Sign;
+
+		if (nu < nv) {
+
+			if (remainder != nullptr)
+				CopyValue(*remainder, first);
 
 			memset(first.Buffer, 0, first.Size * sizeof(WORD));
 		}
 
-		else if (cmp == 0) {
+		// A single word divisor divides the dividend word by word, shifting it on the fly
+		else if (nv == 1) {
 
+			const WORD r = DivideWord(first.Buffer, first.Buffer, nu, second.Normalized.Buffer[0], shift, second.WordReciprocal);
 			if (remainder != nullptr) {
 
 				Resize(*remainder, 1);
-				remainder->Buffer[0] = 0;
+				remainder->Buffer[0] = r;
+			}
+		}
+
+		// Huge divisions use the Barrett reciprocal
+		else if (second.Precision != 0 && nu - nv >= s_NewtonThreshold.load(std::memory_order_relaxed))
+			ReciprocalDivide(first, second.Value, second.Reciprocal, second.Precision, remainder);
+
+		else {
+
+			WORD* r = nullptr;
+			if (remainder != nullptr) {
+
+				if (remainder->Size != nv)
+					Resize(*remainder, nv);
+				r = remainder->Buffer;
 			}
 
+			DivideNormalized(first.Buffer, r, first.Buffer, nu, second.Normalized.Buffer, nv, shift, second.WordReciprocal);
+			memset(first.Buffer + nu - nv + 1, 0, (first.Size - (nu - nv + 1)) * sizeof(WORD));
+		}
+
+		if (remainder != nullptr)
+			remainder->Sign = IsZero(*remainder) ? BI_PLUS_SIGN : sign;
+
+		// Establish sign
+		first.Sign = IsZero(first) ? BI_PLUS_SIGN : sign ^ second.Value.Sign;
+	}
+
+	// --- Exact division ---
+
+	// The longest quotient (in Burnikel-Ziegler thresholds) that the 2-adic division computes faster than the Burnikel-Ziegler one, when the
+	// divisor is at least as long
+	constexpr std::size_t EXACT_DIVISION_MAX_TRIANGLE = 16;
+
+	/// <summary>
+	/// Divides two word arrays exactly with Jebelean's 2-adic method: every quotient word is the low word of the partial dividend times the
+	/// inverse of the divisor's low word. Only the quotient words are needed, so the dividend words above them are never updated
+	/// </summary>
+	/// <param name="q">The quotient (nq words)</param>
+	/// <param name="a">The dividend (its nq least significant words are used and destroyed)</param>
+	/// <param name="nq">The quotient size in words</param>
+	/// <param name="d">The odd divisor</param>
+	/// <param name="nd">The divisor size in words</param>
+	/// <param name="inverse">The inverse of the divisor's low word modulo 2^(word bits) (see InverseWord)</param>
+	static void ExactDivideBasecase(WORD* q, WORD* a, std::size_t nq, const WORD* d, std::size_t nd, WORD inverse) {
+
+		for (std::size_t i = 0; i < nq; i++) {
+
+			q[i] = a[i] * inverse;
+
+			const std::size_t m = std::min(nd, nq - i);
+			const WORD borrow = SubMultWord(a + i, d, m, q[i]);
+			SubWord(a + i + m, nq - i - m, borrow);
+		}
+	}
+
+	void DivExact(BigInt_T& first, const BigInt_T& second) {
+
+		if (IsZero(second))
+			throw std::invalid_argument("Division by zero");
+
+		const bool sign = first.Sign ^ second.Sign;
+		if (CompareU(first, second) < 0) {
+
 			memset(first.Buffer, 0, first.Size * sizeof(WORD));
-			first.Buffer[0] = 1;
+			first.Sign = BI_PLUS_SIGN;
+
+			return;
+		}
+
+		// The divisor's trailing zeros are the dividend's too, so they are shifted out of both
+		BigInt_T d = second;
+		d.Sign = BI_PLUS_SIGN;
+		std::size_t zeros = 0;
+		while (((d.Buffer[zeros / (sizeof(WORD) * 8)] >> (zeros % (sizeof(WORD) * 8))) & 1) == 0)
+			zeros++;
+
+		if (zeros != 0) {
+
+			ShiftRight(d, zeros);
+			ShiftRight(first, zeros);
+		}
+
+		const std::size_t nu = CountSignificantWords(first);
+		const std::size_t nd = CountSignificantWords(d);
+		const std::size_t nq = nu - nd + 1;
+		const std::size_t threshold = s_BurnikelZieglerThreshold.load(std::memory_order_relaxed);
+
+		if (nd == 1)
+			DivExactOddWord(first.Buffer, nu, d.Buffer[0], InverseWord(d.Buffer[0]));
+
+		// The 2-adic method costs about nq * nd word products (nq^2 / 2 if the quotient is not longer than the divisor), so it wins when one
+		// of them is short. Otherwise the ordinary division is faster, even with the remainder it computes
+		else if (nd < threshold || nq < threshold || (nq <= nd && nq < EXACT_DIVISION_MAX_TRIANGLE * threshold)) {
+
+			// Only as many dividend words as the quotient ones are needed to find it
+			ScratchArena arena(nq);
+			WORD* a = arena.Alloc(nq);
+			bi_memcpy(a, nq * sizeof(WORD), first.Buffer, nq * sizeof(WORD));
+			memset(first.Buffer, 0, first.Size * sizeof(WORD));
+
+			ExactDivideBasecase(first.Buffer, a, nq, d.Buffer, nd, InverseWord(d.Buffer[0]));
+		}
+
+		else
+			Div(first, d);
+
+		// Establish sign
+		first.Sign = sign;
+	}
+
+	// --- Montgomery multiplication ---
+
+	/// <summary>
+	/// Reduces a big integer modulo a prepared divisor
+	/// </summary>
+	/// <param name="data">The big integer, replaced by its remainder between 0 and the divisor</param>
+	/// <param name="modulus">The prepared positive divisor</param>
+	static void ReduceModulo(BigInt_T& data, const Divisor_T& modulus) {
+
+		const bool negative = data.Sign == BI_MINUS_SIGN;
+
+		BigInt_T remainder;
+		Div(data, modulus, &remainder);
+
+		// A negative remainder is brought back between 0 and the divisor
+		if (negative && !IsZero(remainder)) {
+
+			BigInt_T complement = modulus.Value;
+			SubU(complement, remainder);
+			CopyValue(remainder, complement);
+		}
+
+		CopyValue(data, remainder);
+		data.Sign = BI_PLUS_SIGN;
+	}
+
+	/// <param name="n">The modulus size in words</param>
+	/// <param name="threads">The number of threads available for the products</param>
+	/// <returns>The scratch size in words of a Montgomery multiplication</returns>
+	static std::size_t MontgomeryScratchSize(std::size_t n, std::size_t threads) {
+
+		return 2 * n + MultScratchSize(n, n, threads);
+	}
+
+	/// <summary>
+	/// Copies a big integer into a word array as long as the modulus, reducing it first if it is not between 0 and the modulus
+	/// </summary>
+	/// <param name="r">The residue (as many words as the modulus)</param>
+	/// <param name="data">The big integer</param>
+	/// <param name="context">The Montgomery context</param>
+	static void LoadResidue(WORD* r, const BigInt_T& data, const Montgomery_T& context) {
+
+		const std::size_t n = context.Size;
+		if (data.Sign == BI_MINUS_SIGN || CompareU(data, context.Modulus.Value) >= 0) {
+
+			BigInt_T reduced = data;
+			ReduceModulo(reduced, context.Modulus);
+			LoadResidue(r, reduced, context);
+
+			return;
+		}
+
+		const std::size_t size = CountSignificantWords(data);
+		bi_memcpy(r, n * sizeof(WORD), data.Buffer, size * sizeof(WORD));
+		memset(r + size, 0, (n - size) * sizeof(WORD));
+	}
+
+	/// <summary>
+	/// Copies a residue into a big integer, without its leading zero words
+	/// </summary>
+	/// <param name="data">The big integer</param>
+	/// <param name="r">The residue</param>
+	/// <param name="n">The residue size in words</param>
+	static void StoreResidue(BigInt_T& data, const WORD* r, std::size_t n) {
+
+		std::size_t size = n;
+		while (size > 1 && r[size - 1] == 0)
+			size--;
+
+		Resize(data, size);
+		bi_memcpy(data.Buffer, data.Size * sizeof(WORD), r, size * sizeof(WORD));
+		data.Sign = BI_PLUS_SIGN;
+	}
+
+	/// <summary>
+	/// Reduces a double-length word array with Montgomery's algorithm (REDC). Every step adds the multiple of the modulus that clears the
+	/// lowest word, whose carry is kept in the cleared word and added back in a single pass at the end
+	/// </summary>
+	/// <param name="r">The result, tR^-1 mod m (as many words as the modulus, it can be t itself or its upper half)</param>
+	/// <param name="t">The word array to reduce (twice as many words as the modulus, less than mR), destroyed</param>
+	/// <param name="context">The Montgomery context</param>
+	static void MontgomeryReduce(WORD* r, WORD* t, const Montgomery_T& context) {
+
+		const std::size_t n = context.Size;
+		const WORD* m = context.Modulus.Value.Buffer;
+
+		for (std::size_t i = 0; i < n; i++)
+			t[i] = AddMultWord(t + i, m, n, t[i] * context.Inverse);
+
+		// The result is below 2m, so one subtraction at most brings it below m
+		const WORD carry = AddWords(t + n, t + n, t, n);
+		if (carry || CompareWords(t + n, m, n) >= 0)
+			SubWords(r, t + n, m, n);
+		else if (r != t + n)
+			bi_memcpy(r, n * sizeof(WORD), t + n, n * sizeof(WORD));
+	}
+
+	/// <summary>
+	/// Multiplies two residues in the Montgomery form (or squares one, if both factors are the same array)
+	/// </summary>
+	/// <param name="r">The product, abR^-1 mod m (it can be one of the factors)</param>
+	/// <param name="a">The first factor</param>
+	/// <param name="b">The second factor</param>
+	/// <param name="context">The Montgomery context</param>
+	/// <param name="arena">The scratch memory arena (see MontgomeryScratchSize)</param>
+	/// <param name="threads">The number of threads available for the product</param>
+	static void MontgomeryMultWords(WORD* r, const WORD* a, const WORD* b, const Montgomery_T& context, ScratchArena& arena, std::size_t threads) {
+
+		const std::size_t n = context.Size;
+		const std::size_t mark = arena.Mark();
+		WORD* t = arena.Alloc(2 * n);
+		memset(t, 0, 2 * n * sizeof(WORD));
+
+		if (a == b)
+			SquareRecursive(t, a, n, arena, threads);
+		else
+			MultRecursive(t, a, n, b, n, arena, threads);
+
+		MontgomeryReduce(r, t, context);
+		arena.Release(mark);
+	}
+
+	/// <param name="bits">The exponent size in bits</param>
+	/// <returns>The sliding window size in bits</returns>
+	static std::size_t WindowSize(std::size_t bits) {
+
+		// A window of k bits needs 2^(k - 1) odd powers, which pay off when they save more products than they cost
+		constexpr std::size_t LIMITS[] = { 7, 25, 81, 241, 673, 1793 };
+
+		std::size_t k = 1;
+		while (k <= sizeof(LIMITS) / sizeof(LIMITS[0]) && bits > LIMITS[k - 1])
+			k++;
+
+		return k;
+	}
+
+	/// <summary>
+	/// Walks the bits of an exponent from the most significant one with the sliding window method. Every window is an odd number of at most
+	/// the given bits, so only the odd powers of the base are needed, and the zero bits between the windows are single squarings
+	/// </summary>
+	/// <param name="exponent">The exponent (greater than zero)</param>
+	/// <param name="window">The window size in bits</param>
+	/// <param name="square">Squares the accumulator</param>
+	/// <param name="mult">Multiplies the accumulator by the odd power base^(2 * index + 1), or loads it into the accumulator the first time</param>
+	template <typename SquareFunction, typename MultFunction>
+	static void SlidingWindow(const BigInt_T& exponent, std::size_t window, SquareFunction square, MultFunction mult) {
+
+		constexpr std::size_t BITS_PER_WORD = sizeof(WORD) * 8;
+
+		const auto bit = [&exponent](std::size_t i) -> WORD { return (exponent.Buffer[i / BITS_PER_WORD] >> (i % BITS_PER_WORD)) & 1; };
+
+		bool first = true;
+		for (std::size_t i = CountSignificantBits(exponent); i--;) {
+
+			if (!bit(i)) {
+
+				square();
+				continue;
+			}
+
+			// The window ends at its lowest set bit
+			std::size_t j = i + 1 >= window ? i + 1 - window : 0;
+			while (!bit(j))
+				j++;
+
+			WORD value = 0;
+			for (std::size_t k = i + 1; k-- > j;)
+				value = (value << 1) | bit(k);
+
+			if (!first)
+				for (std::size_t k = j; k <= i; k++)
+					square();
+
+			mult((std::size_t)(value >> 1), first);
+			first = false;
+			i = j;
+		}
+	}
+
+	void PrepareMontgomery(Montgomery_T& context, const BigInt_T& modulus) {
+
+		constexpr std::size_t BITS_PER_WORD = sizeof(WORD) * 8;
+
+		if ((modulus.Buffer[0] & 1) == 0)
+			throw std::invalid_argument("The Montgomery modulus must be odd");
+
+		BigInt_T m;
+		CopyValue(m, modulus);
+		m.Sign = BI_PLUS_SIGN;
+
+		PrepareDivisor(context.Modulus, m);
+		context.Size = CountSignificantWords(m);
+		context.Inverse = 0 - InverseWord(m.Buffer[0]);
+
+		BigInt_T power;
+		SetPowerOfTwo(power, 2 * context.Size * BITS_PER_WORD);
+		Div(power, context.Modulus, &context.R2);
+	}
+
+	void ToMontgomery(BigInt_T& data, const Montgomery_T& context) {
+
+		const std::size_t n = context.Size;
+		const std::size_t threads = s_ThreadCount.load(std::memory_order_relaxed);
+		ScratchArena arena(2 * n + MontgomeryScratchSize(n, threads));
+		WORD* a = arena.Alloc(n);
+		WORD* r2 = arena.Alloc(n);
+		LoadResidue(a, data, context);
+		LoadResidue(r2, context.R2, context);
+
+		MontgomeryMultWords(a, a, r2, context, arena, threads);
+		StoreResidue(data, a, n);
+	}
+
+	void FromMontgomery(BigInt_T& data, const Montgomery_T& context) {
+
+		const std::size_t n = context.Size;
+		ScratchArena arena(2 * n);
+		WORD* t = arena.Alloc(2 * n);
+		LoadResidue(t, data, context);
+		memset(t + n, 0, n * sizeof(WORD));
+
+		MontgomeryReduce(t, t, context);
+		StoreResidue(data, t, n);
+	}
+
+	void MontgomeryMult(BigInt_T& first, const BigInt_T& second, const Montgomery_T& context) {
+
+		const std::size_t n = context.Size;
+		const std::size_t threads = s_ThreadCount.load(std::memory_order_relaxed);
+		ScratchArena arena(2 * n + MontgomeryScratchSize(n, threads));
+		WORD* a = arena.Alloc(n);
+		WORD* b = arena.Alloc(n);
+		LoadResidue(a, first, context);
+		LoadResidue(b, second, context);
+
+		MontgomeryMultWords(a, a, b, context, arena, threads);
+		StoreResidue(first, a, n);
+	}
+
+	void MontgomerySquare(BigInt_T& data, const Montgomery_T& context) {
+
+		const std::size_t n = context.Size;
+		const std::size_t threads = s_ThreadCount.load(std::memory_order_relaxed);
+		ScratchArena arena(n + MontgomeryScratchSize(n, threads));
+		WORD* a = arena.Alloc(n);
+		LoadResidue(a, data, context);
+
+		MontgomeryMultWords(a, a, a, context, arena, threads);
+		StoreResidue(data, a, n);
+	}
+
+	void MontgomeryPow(BigInt_T& base, const BigInt_T& exponent, const Montgomery_T& context) {
+
+		if (exponent.Sign == BI_MINUS_SIGN && !IsZero(exponent))
+			throw std::invalid_argument("Negative exponent");
+
+		const std::size_t n = context.Size;
+		if (IsZero(exponent)) {
+
+			// 1 mod m (which is 0 only if the modulus is 1)
+			Resize(base, 1);
+			base.Buffer[0] = n > 1 || context.Modulus.Value.Buffer[0] != 1;
+			base.Sign = BI_PLUS_SIGN;
+
+			return;
+		}
+
+		const std::size_t window = WindowSize(CountSignificantBits(exponent));
+		const std::size_t entries = (std::size_t)1 << (window - 1);
+		const std::size_t threads = s_ThreadCount.load(std::memory_order_relaxed);
+		ScratchArena arena((entries + 3) * n + MontgomeryScratchSize(n, threads));
+		WORD* table = arena.Alloc(entries * n);
+		WORD* square = arena.Alloc(n);
+		WORD* acc = arena.Alloc(2 * n);
+
+		// The odd powers of the base in the Montgomery form (base, base^3, base^5, ...)
+		LoadResidue(table, base, context);
+		LoadResidue(acc, context.R2, context);
+		MontgomeryMultWords(table, table, acc, context, arena, threads);
+		if (entries > 1) {
+
+			MontgomeryMultWords(square, table, table, context, arena, threads);
+			for (std::size_t i = 1; i < entries; i++)
+				MontgomeryMultWords(table + i * n, table + (i - 1) * n, square, context, arena, threads);
+		}
+
+		SlidingWindow(exponent, window,
+			[&]() {
+
+				MontgomeryMultWords(acc, acc, acc, context, arena, threads);
+			},
+			[&](std::size_t index, bool load) {
+
+				if (load)
+					bi_memcpy(acc, n * sizeof(WORD), table + index * n, n * sizeof(WORD));
+				else
+					MontgomeryMultWords(acc, acc, table + index * n, context, arena, threads);
+			});
+
+		// Out of the Montgomery form
+		memset(acc + n, 0, n * sizeof(WORD));
+		MontgomeryReduce(acc, acc, context);
+		StoreResidue(base, acc, n);
+	}
+
+	void PowMod(BigInt_T& base, const BigInt_T& exponent, const BigInt_T& modulus) {
+
+		if (IsZero(modulus))
+			throw std::invalid_argument("Division by zero");
+
+		if (exponent.Sign == BI_MINUS_SIGN && !IsZero(exponent))
+			throw std::invalid_argument("Negative exponent");
+
+		if (modulus.Buffer[0] & 1) {
+
+			Montgomery_T context;
+			PrepareMontgomery(context, modulus);
+			MontgomeryPow(base, exponent, context);
+
+			return;
+		}
+
+		// An even modulus has no Montgomery form, so every product is reduced by the prepared modulus
+		BigInt_T m;
+		CopyValue(m, modulus);
+		m.Sign = BI_PLUS_SIGN;
+		Divisor_T divisor;
+		PrepareDivisor(divisor, m);
+
+		ReduceModulo(base, divisor);
+		if (IsZero(exponent)) {
+
+			Resize(base, 1);
+			base.Buffer[0] = 1;
+
+			return;
+		}
+
+		const std::size_t window = WindowSize(CountSignificantBits(exponent));
+		std::vector<BigInt_T> table((std::size_t)1 << (window - 1));
+		CopyValue(table[0], base);
+		if (table.size() > 1) {
+
+			BigInt_T square;
+			CopyValue(square, base);
+			Square(square);
+			ReduceModulo(square, divisor);
+			for (std::size_t i = 1; i < table.size(); i++) {
+
+				CopyValue(table[i], table[i - 1]);
+				Mult(table[i], square);
+				ReduceModulo(table[i], divisor);
+			}
 		}
 
-		else {
+		BigInt_T acc;
+		SlidingWindow(exponent, window,
+			[&]() {
 
-			BigInt_T un = first;
-			un.Sign = BI_PLUS_SIGN;
-			BigInt_T vn = second;
-			vn.Sign = BI_PLUS_SIGN;
+				Square(acc);
+				ReduceModulo(acc, divisor);
+			},
+			[&](std::size_t index, bool load) {
 
-			std::size_t m = CountSignificantWords(un);
-			std::size_t n = CountSignificantWords(vn);
+				if (load)
+					CopyValue(acc, table[index]);
 
-			// D1: Normalize
-			WORD shift = 0;
-			WORD vn_1 = vn.Buffer[n - 1];
-			while (vn_1 < ((WORD)1 << (BITS_PER_WORD - 1))) {
+				else {
 
-				vn_1 <<= 1;
-				shift++;
-			}
+					Mult(acc, table[index]);
+					ReduceModulo(acc, divisor);
+				}
+			});
 
-			ShiftLeft(un, shift);
-			ShiftLeft(vn, shift);
+		CopyValue(base, acc);
+	}
 
-			if (un.Size == m)
-				Resize(un, un.Size + 1);
+	// --- Fixed-base exponentiation ---
 
-			BigInt_T& quotient = first;
-			if (first.Size < m - n + 1)
-				Resize(quotient, m - n + 1);
-			memset(quotient.Buffer, 0, quotient.Size * sizeof(WORD));
+	void PrepareFixedBase(FixedBase_T& data, const BigInt_T& base, const BigInt_T& modulus, std::size_t exponent_bits, std::size_t teeth) {
 
-			// D2-D7: Main loop
-			for (std::size_t i = 0; i <= m - n; i++) {
+		if (teeth > 16)
+			throw std::invalid_argument("The comb teeth must be at most 16");
 
-				std::size_t j = m - n - i;
+		PrepareMontgomery(data.Context, modulus);
+		const std::size_t n = data.Context.Size;
 
-				// D3: Calculate q
-				WORD q = 0, r = 0;
-				WORD dividendHigh = un.Buffer[j + n];
-				WORD dividendLow = un.Buffer[j + n - 1];
-				WORD divisorHigh = vn.Buffer[n - 1];
+		CopyValue(data.Base, base);
+		ReduceModulo(data.Base, data.Context.Modulus);
 
-				if (dividendHigh >= divisorHigh) {
+		if (exponent_bits == 0)
+			exponent_bits = CountSignificantBits(data.Context.Modulus.Value);
 
-					q = BASE;
-					r = dividendLow + divisorHigh;
-				}
+		// The default comb has up to 256 entries, as long as they are fewer than the exponent bits
+		if (teeth == 0) {
 
-				else
-					q = DivideDoubleWordByWord(dividendHigh, dividendLow, divisorHigh, &r);
+			teeth = 1;
+			while (teeth < 8 && ((std::size_t)1 << (teeth + 1)) <= exponent_bits)
+				teeth++;
+		}
 
-				// D3: Test and adjust qhat
-				while (q > 0 && n > 1) {
+		data.Teeth = teeth;
+		data.Spacing = (exponent_bits + teeth - 1) / teeth;
+		data.ExponentBits = data.Spacing * teeth;
+
+		const std::size_t entries = ((std::size_t)1 << teeth) - 1;
+		Clear(data.Table);
+		Resize(data.Table, entries * n);
+		WORD* table = data.Table.Buffer;
+
+		const std::size_t threads = s_ThreadCount.load(std::memory_order_relaxed);
+		ScratchArena arena(n + MontgomeryScratchSize(n, threads));
+		WORD* r2 = arena.Alloc(n);
+		LoadResidue(r2, data.Context.R2, data.Context);
+
+		// The teeth, base^(2^(Spacing * i)), are the entries with a single bit set
+		LoadResidue(table, data.Base, data.Context);
+		MontgomeryMultWords(table, table, r2, data.Context, arena, threads);
+		for (std::size_t i = 1; i < teeth; i++) {
+
+			WORD* tooth = table + (((std::size_t)1 << i) - 1) * n;
+			bi_memcpy(tooth, n * sizeof(WORD), table + (((std::size_t)1 << (i - 1)) - 1) * n, n * sizeof(WORD));
+			for (std::size_t j = 0; j < data.Spacing; j++)
+				MontgomeryMultWords(tooth, tooth, tooth, data.Context, arena, threads);
+		}
 
-					WORD prodHigh, prodLow;
-					MultUWORD(q, vn.Buffer[n - 2], prodLow, prodHigh);
+		// Every other entry is its lowest tooth times an entry computed before it
+		for (std::size_t j = 1; j <= entries; j++) {
 
-					if (prodHigh > r || (prodHigh == r && prodLow > un.Buffer[j + n - 2])) {
+			const std::size_t low = j & (0 - j);
+			if (low != j)
+				MontgomeryMultWords(table + (j - 1) * n, table + (low - 1) * n, table + (j - low - 1) * n, data.Context, arena, threads);
+		}
+	}
 
-						q--;
-						r += divisorHigh;
-						if (r >= divisorHigh)
-							continue;
-					}
+	void FixedBasePow(BigInt_T& exponent, const FixedBase_T& data) {
 
-					break;
-				}
+		constexpr std::size_t BITS_PER_WORD = sizeof(WORD) * 8;
 
-				// D4: Multiply and subtract
-				BigInt_T qhat_v;
-				Resize(qhat_v, vn.Size + 1);
-				Copy(qhat_v, vn);
-				MultiplyByWord(qhat_v, q);
+		if (exponent.Sign == BI_MINUS_SIGN && !IsZero(exponent))
+			throw std::invalid_argument("Negative exponent");
 
-				BigInt_T u_part;
-				Resize(u_part, j + n + 1);
-				bi_memcpy(u_part.Buffer, u_part.Size * sizeof(WORD), un.Buffer + j, (j + n + 1) * sizeof(WORD));
+		const std::size_t bits = CountSignificantBits(exponent);
 
-				// D5: Test remainder - need to adjust
-				if (Compare(u_part, qhat_v) < 0) {
+		// The exponents longer than the table (and zero) take the generic path
+		if (bits > data.ExponentBits || IsZero(exponent)) {
 
-					q--;
+			BigInt_T e = exponent;
+			CopyValue(exponent, data.Base);
+			MontgomeryPow(exponent, e, data.Context);
 
-					// Add back
-					BigInt_T temp;
-					Resize(temp, qhat_v.Size);
-					Copy(temp, qhat_v);
-					Sub(temp, vn);
-					for (std::size_t i = 0; i < n + 1; i++)
-						un.Buffer[j + i] = temp.Buffer[i];
-				}
+			return;
+		}
 
-				else {
+		const auto bit = [&exponent, bits](std::size_t i) -> std::size_t { return i < bits ? (exponent.Buffer[i / BITS_PER_WORD] >> (i % BITS_PER_WORD)) & 1 : 0; };
 
-					BigInt_T temp;
-					Resize(temp, u_part.Size);
-					Copy(temp, u_part);
-					Sub(temp, qhat_v);
-					for (std::size_t i = 0; i < n + 1; i++)
-						un.Buffer[j + i] = temp.Buffer[i];
-				}
+		const std::size_t n = data.Context.Size;
+		const std::size_t threads = s_ThreadCount.load(std::memory_order_relaxed);
+		ScratchArena arena(2 * n + MontgomeryScratchSize(n, threads));
+		WORD* acc = arena.Alloc(2 * n);
+		const WORD* table = data.Table.Buffer;
 
-				quotient.Buffer[j] = q;
-			}
+		// Every column of the comb reads one bit per tooth, which selects the entry to multiply by
+		bool first = true;
+		for (std::size_t column = data.Spacing; column--;) {
 
-			if (remainder != nullptr) {
+			if (!first)
+				MontgomeryMultWords(acc, acc, acc, data.Context, arena, threads);
 
-				Resize(*remainder, CountSignificantWords(un));
-				Copy(*remainder, un);
-				ShiftRight(*remainder, shift);
-				remainder->Sign = first.Sign;
-			}
+			std::size_t index = 0;
+			for (std::size_t i = 0; i < data.Teeth; i++)
+				index |= bit(i * data.Spacing + column) << i;
+
+			if (index == 0)
+				continue;
+
+			if (first)
+				bi_memcpy(acc, n * sizeof(WORD), table + (index - 1) * n, n * sizeof(WORD));
+			else
+				MontgomeryMultWords(acc, acc, table + (index - 1) * n, data.Context, arena, threads);
+
+			first = false;
 		}
 
-		// Establish sign
-		first.Sign = first.Sign ^ second.Sign;
+		// Out of the Montgomery form
+		memset(acc + n, 0, n * sizeof(WORD));
+		MontgomeryReduce(acc, acc, data.Context);
+		StoreResidue(exponent, acc, n);
 	}
 
 	// --- Bitwise functions ---
@@ -1287,7 +5191,7 @@ namespace Utils {
 
 		if (offset != 0) {
 
-			bi_memmove(buffer, data.Size * sizeof(WORD), buffer + offset, data.Size * sizeof(WORD) - offset);
+			bi_memmove(buffer, data.Size * sizeof(WORD), buffer + offset, (data.Size - offset) * sizeof(WORD));
 			memset(buffer + data.Size - offset, 0, offset * sizeof(WORD));
 		}
 
@@ -1311,249 +5215,802 @@ namespace Utils {
 
 	// --- String functions ---
 
-	std::string ToString(const BigInt_T& data) {
+	// The digits of the bases up to 36
+	static const char DIGITS[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+	// The decimal digits of the numbers from 0 to 99
+	static const char DIGIT_PAIRS[] =
+		"0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+		"5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+	// The word size from which the conversion to string splits the number by a power of the base instead of dividing it by a chunk at a time
+	constexpr std::size_t TO_STRING_THRESHOLD = 60;
+
+	// The word size from which the parsing splits the chunks in two halves instead of multiplying by a chunk at a time
+	constexpr std::size_t FROM_STRING_THRESHOLD = 60;
+
+	// A base with the number of its digits that fit in a word (a chunk) and the power of the base they are split by
+	struct Radix {
+
+		WORD Base;
+		std::size_t ChunkDigits;
+		WORD Chunk;
+	};
+
+	/// <summary>
+	/// Finds the largest power of a base that fits in a word (10^19 for the decimal base with 64-bit words)
+	/// </summary>
+	/// <param name="base">The base</param>
+	/// <returns>The base with its chunk</returns>
+	static Radix GetRadix(int base) {
+
+		Radix radix;
+		radix.Base = (WORD)base;
+		radix.ChunkDigits = 1;
+		radix.Chunk = radix.Base;
+		while (radix.Chunk <= BI_MAX_WORD / radix.Base) {
+
+			radix.Chunk *= radix.Base;
+			radix.ChunkDigits++;
+		}
+
+		return radix;
+	}
+
+	/// <returns>The number of bits of a digit if the base is a power of two, 0 if not</returns>
+	static unsigned int GetDigitBits(int base) {
+
+		if ((base & (base - 1)) != 0)
+			return 0;
+
+		unsigned int bits = 0;
+		while ((1 << bits) < base)
+			bits++;
+
+		return bits;
+	}
+
+	/// <returns>The value of a digit in any base up to 36 (letters in both cases), or 36 if the character is not a digit</returns>
+	static unsigned int DigitValue(char c) {
+
+		if (c >= '0' && c <= '9')
+			return c - '0';
+
+		if (c >= 'a' && c <= 'z')
+			return c - 'a' + 10;
+
+		if (c >= 'A' && c <= 'Z')
+			return c - 'A' + 10;
+
+		return 36;
+	}
+
+#if defined(BI_X64_KERNELS)
+
+	// The decimal digits that the vector kernels convert at once, and their power of ten
+	constexpr std::size_t DECIMAL_VECTOR_DIGITS = 16;
+	constexpr WORD DECIMAL_VECTOR_CHUNK = 10000000000000000ULL;
+
+	/// <summary>
+	/// Splits a number below 10^8 into its decimal digits with multiplications by reciprocals instead of divisions. The number is cut in
+	/// two halves of four digits, whose prefixes (a, ab, abc, abcd) are found at once dividing by 1000, 100, 10 and 1, and every digit is
+	/// a prefix minus ten times the previous one
+	/// </summary>
+	/// <param name="value">The number, less than 10^8</param>
+	/// <returns>The eight digits as 16-bit lanes, from the most significant one</returns>
+	static __m128i SplitDecimal8SSE2(std::uint32_t value) {
+
+		// abcd = abcdefgh / 10^4 (0xd1b71759 / 2^45 is the reciprocal of 10^4 rounded up), efgh = abcdefgh - abcd * 10^4
+		const __m128i abcdefgh = _mm_cvtsi32_si128((int)value);
+		const __m128i abcd = _mm_srli_epi64(_mm_mul_epu32(abcdefgh, _mm_set1_epi32((int)0xd1b71759)), 45);
+		const __m128i efgh = _mm_sub_epi32(abcdefgh, _mm_mul_epu32(abcd, _mm_set1_epi32(10000)));
+
+		// Every half fills four lanes, times 4 to keep two more bits in the high halves of the products
+		const __m128i halves = _mm_slli_epi64(_mm_unpacklo_epi16(abcd, efgh), 2);
+		const __m128i pairs = _mm_unpacklo_epi16(halves, halves);
+		const __m128i lanes = _mm_unpacklo_epi32(pairs, pairs);
+
+		// 4x * (2^23 / 10^3, 2^19 / 10^2, 2^17 / 10, 2^15) / 2^16, then shifted right by 9, 5, 3 and 1 bits
+		const __m128i reciprocals = _mm_setr_epi16(8389, 5243, 13108, (short)32768, 8389, 5243, 13108, (short)32768);
+		const __m128i shifts = _mm_setr_epi16(1 << 7, 1 << 11, 1 << 13, (short)(1 << 15), 1 << 7, 1 << 11, 1 << 13, (short)(1 << 15));
+		const __m128i prefixes = _mm_mulhi_epu16(_mm_mulhi_epu16(lanes, reciprocals), shifts);
+
+		// The previous prefixes are one lane before, within the same half
+		return _mm_sub_epi16(prefixes, _mm_slli_epi64(_mm_mullo_epi16(prefixes, _mm_set1_epi16(10)), 16));
+	}
+
+	/// <summary>
+	/// Writes the sixteen decimal digits of a number (SSE2 is part of x86-64, so it needs no check)
+	/// </summary>
+	/// <param name="str">The digits (exactly sixteen, with the zeros at the start)</param>
+	/// <param name="value">The number, less than 10^16</param>
+	static void WriteDecimal16SSE2(char* str, WORD value) {
+
+		const __m128i high = SplitDecimal8SSE2((std::uint32_t)(value / 100000000));
+		const __m128i low = SplitDecimal8SSE2((std::uint32_t)(value % 100000000));
+		const __m128i digits = _mm_add_epi8(_mm_packus_epi16(high, low), _mm_set1_epi8('0'));
+		_mm_storeu_si128((__m128i*)str, digits);
+	}
+
+	/// <summary>
+	/// Reads sixteen decimal digits multiplying and adding the neighbouring groups: the pairs, then the groups of four and of eight digits
+	/// </summary>
+	/// <param name="str">The digits (already validated)</param>
+	/// <returns>The number</returns>
+	BI_TARGET("sse4.1") static WORD ReadDecimal16SSE41(const char* str) {
+
+		const __m128i digits = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)str), _mm_set1_epi8('0'));
+		const __m128i pairs = _mm_maddubs_epi16(digits, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+		const __m128i quads = _mm_madd_epi16(pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+		const __m128i octets = _mm_madd_epi16(_mm_packus_epi32(quads, quads), _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+
+		return (WORD)(std::uint32_t)_mm_cvtsi128_si32(octets) * 100000000 + (std::uint32_t)_mm_extract_epi32(octets, 1);
+	}
+
+	/// <summary>
+	/// Finds the first character that is not a decimal digit, checking 32 characters at a time
+	/// </summary>
+	/// <param name="str">The characters</param>
+	/// <param name="length">The number of characters</param>
+	/// <returns>The number of digits at the start</returns>
+	BI_TARGET("avx2") static std::size_t ScanDecimalAVX2(const char* str, std::size_t length) {
+
+		const __m256i zero = _mm256_set1_epi8('0');
+		const __m256i nine = _mm256_set1_epi8(9);
+
+		// A character is a digit if its distance from '0' is at most 9 as an unsigned byte
+		std::size_t i = 0;
+		for (; i + 32 <= length; i += 32) {
+
+			const __m256i values = _mm256_sub_epi8(_mm256_loadu_si256((const __m256i*)(str + i)), zero);
+			if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(values, nine), nine)) != -1)
+				break;
+		}
+
+		// The block with the first character that is not a digit and the last characters are checked one at a time
+		while (i < length && (unsigned char)(str[i] - '0') <= 9)
+			i++;
+
+		return i;
+	}
+
+#endif
+
+	/// <summary>
+	/// Finds the first character that is not a digit of a base
+	/// </summary>
+	/// <param name="str">The characters</param>
+	/// <param name="length">The number of characters</param>
+	/// <param name="base">The base</param>
+	/// <returns>The number of digits at the start</returns>
+	static std::size_t ScanDigits(const char* str, std::size_t length, int base) {
+
+#if defined(BI_X64_KERNELS)
+		if (base == 10 && s_HasAVX2)
+			return ScanDecimalAVX2(str, length);
+#endif
+
+		std::size_t i = 0;
+		while (i < length && DigitValue(str[i]) < (unsigned int)base)
+			i++;
+
+		return i;
+	}
+
+	// A power of a base B^(c * 2^k), where c is the number of digits in a chunk, and its prepared divisor (only once a conversion to
+	// string has divided by it)
+	struct RadixPower {
+
+		BigInt_T Value;
+		Divisor_T Divisor;
+		bool Prepared = false;
+	};
+
+	// The powers of every base from k = 0, shared by the conversions and kept for the next ones
+	static std::vector<std::unique_ptr<RadixPower>> s_RadixPowers[37];
+	static std::mutex s_RadixPowersMutex;
+
+	/// <summary>
+	/// Gets the powers of a base B^(c * 2^k), computing the missing ones by squaring the last one
+	/// </summary>
+	/// <param name="radix">The base</param>
+	/// <param name="powers">The powers from k = 0</param>
+	/// <param name="count">The number of powers needed</param>
+	/// <param name="prepared">True to prepare their divisors too</param>
+	static void GetRadixPowers(const Radix& radix, std::vector<const RadixPower*>& powers, std::size_t count, bool prepared) {
 
-		// Shifts left by one bit
-		void(*ShiftLeft1)(std::uint8_t* buffer, std::size_t size_in_bytes)
-		=
-		[](std::uint8_t* buffer, std::size_t size_in_bytes) {
+		std::lock_guard<std::mutex> lock(s_RadixPowersMutex);
+		std::vector<std::unique_ptr<RadixPower>>& cache = s_RadixPowers[radix.Base];
+		while (cache.size() < count) {
 
-			std::uint8_t* byte;
-			for (byte = (std::uint8_t*)buffer; size_in_bytes--; byte++) {
+			std::unique_ptr<RadixPower> power(new RadixPower());
+			if (cache.empty())
+				power->Value.Buffer[0] = radix.Chunk;
 
-				std::uint8_t bit = 0;
-				if (size_in_bytes)
-					bit = byte[1] & (1 << (CHAR_BIT - 1)) ? 1 : 0;
+			else {
 
-				*byte <<= 1;
-				*byte |= bit;
+				CopyValue(power->Value, cache.back()->Value);
+				Square(power->Value);
 			}
-		};
 
-		// Shifts left by 4 bits
-		void(*ShiftLeft4)(std::uint8_t* buffer, std::size_t size_in_bytes)
-		=
-		[](std::uint8_t* buffer, std::size_t size_in_bytes) {
+			cache.push_back(std::move(power));
+		}
 
-			std::uint8_t* byte;
-			for (byte = (std::uint8_t*)buffer; size_in_bytes--; byte++) {
+		powers.clear();
+		for (std::size_t i = 0; i < count; i++) {
 
-				std::uint8_t bit = 0;
-				if (size_in_bytes)
-					bit = (byte[1] & (0xFF << (CHAR_BIT - 4))) >> (CHAR_BIT - 4);
+			RadixPower& power = *cache[i];
+			if (prepared && !power.Prepared) {
 
-				*byte <<= 4;
-				*byte |= bit;
+				PrepareDivisor(power.Divisor, power.Value);
+				power.Prepared = true;
 			}
-		};
 
-		// Big integer significant bits
-		const std::size_t significantBits = CountSignificantBits(data);
+			powers.push_back(&power);
+		}
+	}
+
+	/// <summary>
+	/// Writes the digits of a chunk
+	/// </summary>
+	/// <param name="str">The digits (exactly c, with the zeros at the start)</param>
+	/// <param name="chunk">The chunk, less than B^c</param>
+	/// <param name="radix">The base</param>
+	static void WriteChunk(char* str, WORD chunk, const Radix& radix) {
 
-		// Size in bytes = ceil(4*ceil(n/3)/8) + 1
-		// The last one is needed as an auxiliary buffer to store the first 8 bits in the number
-		const std::size_t bcdBufferSize = 2 * (std::size_t)ceil(ceil((long double)significantBits / 3.0) / 2.0) + 1;
+#if defined(BI_X64_KERNELS)
+		// The last sixteen decimal digits are written at once, the first three (a number below 1000) one pair and one digit
+		if (radix.Base == 10) {
 
-		// The binary-coded decimal buffer
-		std::uint8_t* bcdBuffer = (std::uint8_t*)calloc(bcdBufferSize, sizeof(std::uint8_t));
-		if (bcdBuffer == NULL)
-			return "0";
+			const WORD high = chunk / DECIMAL_VECTOR_CHUNK;
+			WriteDecimal16SSE2(str + 3, chunk - high * DECIMAL_VECTOR_CHUNK);
 
-		std::uint8_t* buffer = (std::uint8_t*)data.Buffer; // Big integer buffer as byte array
-		const std::size_t bufferSize = (std::size_t)ceil((long double)significantBits / 8.0); // Big integer buffer size as byte array
-		const std::size_t shiftAmount = bufferSize * 8; // The amount of shifts needed to convert from binary representation to binary-coded decimal representation
-		const std::size_t AUX_BUFFER_INDEX = bcdBufferSize - 1; // The index of the auxiliary buffer in the bcdBuffer (the last buffer's cell)
-		for (std::size_t shift = 0; shift < shiftAmount; shift++) {
+			const char* pair = DIGIT_PAIRS + 2 * (high % 100);
+			str[2] = pair[1];
+			str[1] = pair[0];
+			str[0] = (char)('0' + high / 100);
 
-			// If the shift counter consumes all the bits in the auxiliar buffer, refill it with new data from the big integer buffer
-			if (shift % 8 == 0)
-				bcdBuffer[AUX_BUFFER_INDEX] = buffer[bufferSize - 1 - shift / 8];
+			return;
+		}
+#endif
 
-			// Check every 4 bits if there is at least 5. If so, add 3 to the 4 bits
-			for (std::size_t i = AUX_BUFFER_INDEX / 2; i < AUX_BUFFER_INDEX; i++) { // - (shift / 8 + 1)
+		std::size_t end = radix.ChunkDigits;
+		if (radix.Base == 10) {
 
-				if (bcdBuffer[i] == 0)
-					continue;
+			// The decimal digits are written in pairs, so the last one is written alone when they are odd
+			for (; end > 1; end -= 2) {
 
-				// Check the high bits...
+				const char* pair = DIGIT_PAIRS + 2 * (chunk % 100);
+				str[end - 1] = pair[1];
+				str[end - 2] = pair[0];
+				chunk /= 100;
+			}
 
-				std::uint8_t digit = (bcdBuffer[i] & HIGH_BITS) >> 4;
-				if (digit > 4) {
+			if (end == 1)
+				str[0] = (char)('0' + chunk);
 
-					digit += 3;
-					bcdBuffer[i] = (digit << 4) | (LOW_BITS & bcdBuffer[i]);
-				}
+			return;
+		}
 
-				// and the low bits
+		while (end > 0) {
 
-				digit = bcdBuffer[i] & LOW_BITS;
-				if (digit > 4) {
+			str[--end] = DIGITS[chunk % radix.Base];
+			chunk /= radix.Base;
+		}
+	}
 
-					digit += 3;
-					bcdBuffer[i] = digit | (HIGH_BITS & bcdBuffer[i]);
-				}
+	/// <summary>
+	/// Writes a magnitude as digits dividing it by a chunk at a time, from the least significant digits
+	/// </summary>
+	/// <param name="str">The digits (the ones not needed by the number are set to zero)</param>
+	/// <param name="digits">The number of digits to write (enough for the number)</param>
+	/// <param name="words">The magnitude's words (they are consumed)</param>
+	/// <param name="n">The number of words</param>
+	/// <param name="radix">The base</param>
+	static void WriteDigitsBasecase(char* str, std::size_t digits, WORD* words, std::size_t n, const Radix& radix) {
+
+		const unsigned int shift = NormalizationShift(radix.Chunk);
+		const WORD d = radix.Chunk << shift;
+		const WORD reciprocal = ReciprocalWord(d);
+
+		std::size_t end = digits;
+		while (n > 1 || words[0] != 0) {
+
+			const WORD chunk = DivideWord(words, words, n, d, shift, reciprocal);
+			if (n > 1 && words[n - 1] == 0)
+				n--;
+
+			if (end >= radix.ChunkDigits) {
+
+				end -= radix.ChunkDigits;
+				WriteChunk(str + end, chunk, radix);
 			}
 
-			// Shift left by one position
-			ShiftLeft1(bcdBuffer, bcdBufferSize);
+			// The most significant chunk can have fewer digits than the ones left
+			else {
+
+				char buffer[sizeof(WORD) * 8];
+				WriteChunk(buffer, chunk, radix);
+				bi_memcpy(str, end, buffer + radix.ChunkDigits - end, end);
+				end = 0;
+			}
 		}
 
-		// Shift the bits in the correct position to create the string buffer
-		for (std::size_t i = 0; i < AUX_BUFFER_INDEX; i++) {
+		memset(str, '0', end);
+	}
 
-			ShiftLeft4(bcdBuffer, AUX_BUFFER_INDEX - i);
-			bcdBuffer[bcdBufferSize - 2 - i] >>= 4;
+	/// <summary>
+	/// Writes a magnitude as digits splitting it by a power of the base, so the conversion runs at the speed of the division
+	/// </summary>
+	/// <param name="str">The digits (the ones not needed by the number are set to zero)</param>
+	/// <param name="digits">The number of digits to write (enough for the number, at most c * 2^level)</param>
+	/// <param name="data">The magnitude, less than B^digits (it is consumed)</param>
+	/// <param name="level">The power level</param>
+	/// <param name="radix">The base</param>
+	/// <param name="powers">The prepared powers of the base below the level</param>
+	static void WriteDigits(char* str, std::size_t digits, BigInt_T& data, std::size_t level, const Radix& radix, const std::vector<const RadixPower*>& powers) {
+
+		// The levels whose low half alone covers the digits are skipped
+		while (level > 0 && digits <= (radix.ChunkDigits << (level - 1)))
+			level--;
+
+		const std::size_t n = CountSignificantWords(data);
+		if (level == 0 || n < TO_STRING_THRESHOLD) {
+
+			WriteDigitsBasecase(str, digits, data.Buffer, n, radix);
+			return;
 		}
 
-		// Remove the useless bits at the start
-		std::size_t offset = 0;
-		for (; offset < bcdBufferSize - 1; offset++)
-			if (bcdBuffer[offset] != 0)
-				break;
+		// The high half is the quotient, the low half is the remainder with exactly c * 2^(level - 1) digits
+		const std::size_t lowDigits = radix.ChunkDigits << (level - 1);
+		BigInt_T low;
+		Div(data, powers[level - 1]->Divisor, &low);
+		WriteDigits(str, digits - lowDigits, data, level - 1, radix, powers);
+		WriteDigits(str + digits - lowDigits, lowDigits, low, level - 1, radix, powers);
+	}
 
-		// If the number is zero
-		if (offset == AUX_BUFFER_INDEX)
-			return "0";
+	/// <summary>
+	/// Writes a magnitude in a power of two base slicing its bits, from the least significant digits
+	/// </summary>
+	/// <param name="str">The digits</param>
+	/// <param name="digits">The number of digits to write (exactly the ones of the number)</param>
+	/// <param name="data">The magnitude</param>
+	/// <param name="bits">The number of bits of a digit</param>
+	static void WriteBits(char* str, std::size_t digits, const BigInt_T& data, unsigned int bits) {
 
-		// Create the actual digit string
-		std::string digitStr;
-		digitStr.resize(bcdBufferSize - 1 - offset + data.Sign);
-		bi_memcpy(digitStr.data() + data.Sign, bcdBufferSize - 1 - offset + data.Sign, bcdBuffer + offset, bcdBufferSize - 1 - offset);
-		if (data.Sign)
-			digitStr[0] = '-';
+		constexpr std::size_t BITS_PER_WORD = sizeof(WORD) * 8;
 
-		// Convert from binary number to the ASCII character number
-		for (std::size_t i = data.Sign; i < digitStr.size(); i++)
-			digitStr[i] += 48;
+		const std::size_t n = CountSignificantWords(data);
+		const WORD mask = ((WORD)1 << bits) - 1;
+		for (std::size_t i = 0; i < digits; i++) {
 
-		// Free the bcd buffer
-		free(bcdBuffer);
+			const std::size_t offset = i * bits;
+			const std::size_t word = offset / BITS_PER_WORD;
+			const std::size_t shift = offset % BITS_PER_WORD;
 
-		return digitStr;
+			// A digit can take the bits of two words
+			WORD value = data.Buffer[word] >> shift;
+			if (shift + bits > BITS_PER_WORD && word + 1 < n)
+				value |= data.Buffer[word + 1] << (BITS_PER_WORD - shift);
+
+			str[digits - 1 - i] = DIGITS[value & mask];
+		}
 	}
 
-	bool FromString(BigInt_T& data, const std::string& str) {
+	/// <summary>
+	/// Writes the magnitude of a non-zero big integer in a base. Below the divide-and-conquer threshold it works on a copy on the stack, so
+	/// it does not allocate
+	/// </summary>
+	/// <param name="str">The digits (the ones not needed by the number are set to zero)</param>
+	/// <param name="digits">The number of digits to write (exactly the ones of the number for the power of two bases, enough for it otherwise)</param>
+	/// <param name="data">The big integer</param>
+	/// <param name="base">The base</param>
+	static void WriteNumber(char* str, std::size_t digits, const BigInt_T& data, int base) {
+
+		// A power of two base takes the same bits for every digit, so they are read straight from the words
+		const unsigned int bits = GetDigitBits(base);
+		if (bits != 0) {
+
+			WriteBits(str, digits, data, bits);
+			return;
+		}
+
+		const Radix radix = GetRadix(base);
+		const std::size_t n = CountSignificantWords(data);
+		if (n < TO_STRING_THRESHOLD) {
+
+			WORD words[TO_STRING_THRESHOLD];
+			bi_memcpy(words, sizeof(words), data.Buffer, n * sizeof(WORD));
+			WriteDigitsBasecase(str, digits, words, n, radix);
 
-		// Shifts right by one bit
-		void(*ShiftRight1)(std::uint8_t* buffer, std::size_t size_in_bytes)
-		=
-		[](std::uint8_t* buffer, std::size_t size_in_bytes) {
+			return;
+		}
 
-			std::uint8_t* byte;
-			for (byte = size_in_bytes - 1 + (std::uint8_t*)buffer; size_in_bytes--; byte--) {
+		// The smallest power level that covers the digits
+		std::size_t level = 0;
+		while ((radix.ChunkDigits << level) < digits)
+			level++;
 
-				std::uint8_t bit = 0;
-				if (size_in_bytes)
-					bit = byte[-1] & 1 ? 1 : 0;
+		std::vector<const RadixPower*> powers;
+		GetRadixPowers(radix, powers, level, true);
+
+		BigInt_T magnitude;
+		CopyValue(magnitude, data);
+		magnitude.Sign = BI_PLUS_SIGN;
+		WriteDigits(str, digits, magnitude, level, radix, powers);
+	}
 
-				*byte >>= 1;
-				*byte |= (bit << (CHAR_BIT - 1));
+	/// <summary>
+	/// Checks if a magnitude reaches a power of a base
+	/// </summary>
+	/// <param name="data">The magnitude</param>
+	/// <param name="exponent">The power's exponent</param>
+	/// <param name="radix">The base</param>
+	/// <returns>True if |data| >= B^exponent</returns>
+	static bool ReachesPower(const BigInt_T& data, std::size_t exponent, const Radix& radix) {
+
+		// B^exponent = (B^c)^q * B^r, with B^r less than a chunk
+		const std::size_t q = exponent / radix.ChunkDigits;
+		WORD rest = 1;
+		for (std::size_t i = exponent % radix.ChunkDigits; i > 0; i--)
+			rest *= radix.Base;
+
+		const std::size_t n = CountSignificantWords(data);
+		if (n < TO_STRING_THRESHOLD) {
+
+			// The power is built on the stack, a chunk at a time, until it takes more words than the magnitude
+			WORD power[TO_STRING_THRESHOLD];
+			power[0] = rest;
+			std::size_t size = 1;
+			for (std::size_t i = 0; i < q; i++) {
+
+				const WORD carry = MultWord(power, power, size, radix.Chunk);
+				if (carry != 0) {
+
+					if (size == n)
+						return false;
+
+					power[size++] = carry;
+				}
 			}
-		};
 
-		// If the string is empty, return null
-		if (str.empty())
-			return false;
+			if (size != n)
+				return size < n;
 
-		// Check if the number is positive or negative
-		data.Sign = str.at(0) == '-';
-		const std::size_t strLength = data.Sign ? str.length() - 1 : str.length();
-		if (strLength == 0)
-			return false;
+			for (std::size_t i = n; i--;)
+				if (data.Buffer[i] != power[i])
+					return data.Buffer[i] > power[i];
+
+			return true;
+		}
+
+		// A huge power is the product of the cached powers B^(c * 2^k) for the bits of q
+		std::size_t levels = 0;
+		while ((q >> levels) != 0)
+			levels++;
+
+		std::vector<const RadixPower*> powers;
+		GetRadixPowers(radix, powers, levels, false);
+
+		BigInt_T power;
+		power.Buffer[0] = rest;
+		for (std::size_t k = 0; k < levels; k++)
+			if ((q >> k) & 1)
+				Mult(power, powers[k]->Value);
+
+		return CompareU(data, power) >= 0;
+	}
+
+	std::size_t CountDigits(const BigInt_T& data, int base) {
+
+		if (base < 2 || base > 36)
+			throw std::invalid_argument("Invalid base");
+
+		if (IsZero(data))
+			return 1;
+
+		const std::size_t bitCount = CountSignificantBits(data);
+		const unsigned int bits = GetDigitBits(base);
+		if (bits != 0)
+			return (bitCount + bits - 1) / bits;
+
+		// 2^(b - 1) <= |data| < 2^b, so the digits are between floor((b - 1) / log2(B)) + 1 and floor(b / log2(B)) + 1 (a little further apart
+		// for the rounding of the logarithm), which differ by one at most
+		const long double digitsPerBit = 1.0l / std::log2((long double)base);
+		std::size_t digits = (std::size_t)((bitCount - 1) * digitsPerBit * (1.0l - 1e-12l)) + 1;
+		const std::size_t maxDigits = (std::size_t)(bitCount * digitsPerBit * (1.0l + 1e-12l)) + 1;
+
+		const Radix radix = GetRadix(base);
+		while (digits < maxDigits && ReachesPower(data, digits, radix))
+			digits++;
 
-		// Check the string is made up by numbers only
-		for (std::size_t i = data.Sign; i < str.length(); i++)
-			if (str.at(i) < '0' || str.at(i) > '9')
-				return false;
+		return digits;
+	}
 
-		// Reverse double dabble algorithm
+	std::string ToString(const BigInt_T& data, int base) {
 
-		// Size in bytes = ceil(string length / 2) + 1
-		// The last one is needed as an auxiliary buffer to store the first 8 bits in the final number
-		const std::size_t bcdBufferSize = (std::size_t)(std::ceil((long double)strLength / 2.0)) + 1;
+		if (base < 2 || base > 36)
+			throw std::invalid_argument("Invalid base");
 
-		// The binary-coded decimal buffer
-		std::uint8_t* bcdBuffer = (std::uint8_t*)calloc(bcdBufferSize, sizeof(std::uint8_t));
-		if (bcdBuffer == NULL)
+		if (IsZero(data))
 			return "0";
 
-		// Fill the bcd buffer with the provided data.
-		// It starts at the end to ensure the last bits are adjacent to the auxiliary buffer,
-		// so the algorithm can right shift them in the correct position
+		// The power of two bases know their digits exactly, the others write an upper bound of them (with a margin for the rounding of the
+		// logarithm) and remove the zeros at the start
+		std::size_t digits;
+		if (GetDigitBits(base) != 0)
+			digits = CountDigits(data, base);
+		else
+			digits = (std::size_t)(CountSignificantBits(data) / std::log2((double)base)) + 2;
+
+		// The first character is kept for the sign
+		std::string digitStr(1 + digits, '0');
+		WriteNumber(&digitStr[1], digits, data, base);
+
+		std::size_t offset = digitStr.find_first_not_of('0', 1);
+		if (data.Sign == BI_MINUS_SIGN)
+			digitStr[--offset] = '-';
+		digitStr.erase(0, offset);
+
+		return digitStr;
+	}
+
+	char* ToChars(char* first, char* last, const BigInt_T& data, int base) {
 
-		long double i = 0.0;
-		std::size_t strIndex = 0;
-		std::uint8_t nibble_offset = LOW_BITS;
-		std::uint8_t shiftAmount = 0;
-		while (strIndex < strLength) {
+		const bool negative = data.Sign == BI_MINUS_SIGN && !IsZero(data);
+		const std::size_t digits = CountDigits(data, base);
+		if ((std::size_t)(last - first) < negative + digits)
+			return nullptr;
 
-			bcdBuffer[bcdBufferSize - 2 - (std::size_t)i] |= ((std::uint8_t)(str.at(strLength - 1 - strIndex + data.Sign) - '0') << shiftAmount) & nibble_offset;
-			nibble_offset = ~nibble_offset;
-			shiftAmount = shiftAmount == 4 ? 0 : 4;
-			i += 0.5;
-			strIndex++;
+		if (negative)
+			*first++ = '-';
+
+		if (IsZero(data))
+			*first = '0';
+		else
+			WriteNumber(first, digits, data, base);
+
+		return first + digits;
+	}
+
+	/// <summary>
+	/// Reads the digits of a chunk
+	/// </summary>
+	/// <param name="digits">The digits (at most c)</param>
+	/// <param name="length">The number of digits</param>
+	/// <param name="radix">The base</param>
+	/// <returns>The chunk</returns>
+	static WORD ReadChunk(const char* digits, std::size_t length, const Radix& radix) {
+
+#if defined(BI_X64_KERNELS)
+		// The last sixteen decimal digits are read at once
+		if (radix.Base == 10 && length >= DECIMAL_VECTOR_DIGITS && s_HasSSE41) {
+
+			WORD high = 0;
+			for (std::size_t i = 0; i < length - DECIMAL_VECTOR_DIGITS; i++)
+				high = high * 10 + (WORD)(digits[i] - '0');
+
+			return high * DECIMAL_VECTOR_CHUNK + ReadDecimal16SSE41(digits + length - DECIMAL_VECTOR_DIGITS);
 		}
+#endif
 
-		// Set up data
+		WORD chunk = 0;
+		for (std::size_t i = 0; i < length; i++)
+			chunk = chunk * radix.Base + DigitValue(digits[i]);
+
+		return chunk;
+	}
 
-		const std::size_t dataSize = (std::size_t)std::ceil(std::ceil((long double)strLength * log2(10.0l)) / (sizeof(WORD) * 8.0l));
-		bool capacityAlreadySet = false; // To remove unnecessary padding caused by the instruction up here. But if the capacity was stored by the user, keep the padding at the end of this function
+	/// <summary>
+	/// Finds the words that a number of the given digits can take
+	/// </summary>
+	/// <param name="length">The number of digits</param>
+	/// <param name="radix">The base</param>
+	/// <returns>The words of B^length (with a margin for the rounding of the logarithm)</returns>
+	static std::size_t MaxWords(std::size_t length, const Radix& radix) {
 
-		if (data.Size < dataSize) {
+		constexpr std::size_t BITS_PER_WORD = sizeof(WORD) * 8;
 
-			Clear(data);
-			Resize(data, dataSize);
+		const std::size_t bits = (std::size_t)(length * std::log2((long double)radix.Base)) + 2;
+		return (bits + BITS_PER_WORD - 1) / BITS_PER_WORD;
+	}
+
+	/// <summary>
+	/// Reads digits into a magnitude a chunk at a time (c digits), from the most significant one
+	/// </summary>
+	/// <param name="words">The magnitude's words (set to zero, as many as MaxWords)</param>
+	/// <param name="digits">The digits</param>
+	/// <param name="length">The number of digits</param>
+	/// <param name="radix">The base</param>
+	static void ReadDigitsBasecase(WORD* words, const char* digits, std::size_t length, const Radix& radix) {
+
+		// The most significant chunk can be shorter
+		std::size_t end = length % radix.ChunkDigits;
+		if (end == 0)
+			end = radix.ChunkDigits;
+
+		// words = words * B^c + chunk, which is less than (words + 1) * B^c, so the two carries make at most one more word
+		std::size_t n = 0;
+		for (std::size_t begin = 0; begin < length; begin = end, end += radix.ChunkDigits) {
+
+			const WORD chunk = ReadChunk(digits + begin, end - begin, radix);
+			const WORD carry = MultWord(words, words, n, radix.Chunk) + AddWord(words, n, chunk);
+			if (carry != 0)
+				words[n++] = carry;
 		}
+	}
 
-		else {
+	/// <summary>
+	/// Reads digits into a magnitude splitting their chunks in two halves, combined as high * B^(c * 2^k) + low, so the conversion runs at
+	/// the speed of the multiplication
+	/// </summary>
+	/// <param name="data">The magnitude</param>
+	/// <param name="digits">The digits</param>
+	/// <param name="length">The number of digits</param>
+	/// <param name="radix">The base</param>
+	/// <param name="powers">The powers of the base, up to the largest one below the chunks</param>
+	static void ReadDigits(BigInt_T& data, const char* digits, std::size_t length, const Radix& radix, const std::vector<const RadixPower*>& powers) {
+
+		const std::size_t m = (length + radix.ChunkDigits - 1) / radix.ChunkDigits;
+		if (m < FROM_STRING_THRESHOLD) {
 
-			capacityAlreadySet = true;
+			Resize(data, MaxWords(length, radix));
 			memset(data.Buffer, 0, data.Size * sizeof(WORD));
+			ReadDigitsBasecase(data.Buffer, digits, length, radix);
+
+			return;
 		}
 
-		std::size_t offset = 0;
-		std::uint8_t* buffer = (std::uint8_t*)data.Buffer;
-		for (std::size_t shift = 0; shift <= dataSize * sizeof(WORD) * 8; shift++) { // '<=' because we need to shift the last bit into the auxiliary buffer
+		// The low half has 2^level chunks, the largest power of two below their number
+		std::size_t level = 0;
+		while (((std::size_t)2 << level) < m)
+			level++;
 
-			// When we have shifted 8 bits in the auxiliar buffer, transfer it to the buffer
-			if (shift > 0 && shift % 8 == 0) {
+		const std::size_t lowLength = radix.ChunkDigits << level;
+		ReadDigits(data, digits, length - lowLength, radix, powers);
+		Mult(data, powers[level]->Value);
 
-				buffer[shift / 8 - 1] = bcdBuffer[bcdBufferSize - 1];
-				offset++;
-			}
+		BigInt_T low;
+		ReadDigits(low, digits + length - lowLength, lowLength, radix, powers);
+		AddU(data, low);
+	}
+
+	/// <summary>
+	/// Reads the digits of a power of two base into a magnitude placing their bits, from the least significant digits
+	/// </summary>
+	/// <param name="words">The magnitude's words (set to zero, enough for the bits of the digits)</param>
+	/// <param name="digits">The digits</param>
+	/// <param name="length">The number of digits</param>
+	/// <param name="bits">The number of bits of a digit</param>
+	static void ReadBits(WORD* words, const char* digits, std::size_t length, unsigned int bits) {
+
+		constexpr std::size_t BITS_PER_WORD = sizeof(WORD) * 8;
 
-			// Shift right by one position
-			ShiftRight1(bcdBuffer, bcdBufferSize);
+		for (std::size_t i = 0; i < length; i++) {
 
-			// We start from an offset to avoid checking values that have already been processed
-			for (std::size_t i = offset; i < bcdBufferSize - 1; i++) {
+			const std::size_t offset = i * bits;
+			const std::size_t word = offset / BITS_PER_WORD;
+			const std::size_t shift = offset % BITS_PER_WORD;
 
-				if (bcdBuffer[i] == 0)
-					continue;
+			// A digit can give its bits to two words
+			const WORD value = DigitValue(digits[length - 1 - i]);
+			words[word] |= value << shift;
+			if (shift + bits > BITS_PER_WORD)
+				words[word + 1] |= value >> (BITS_PER_WORD - shift);
+		}
+	}
+
+	/// <summary>
+	/// Makes room for a number, growing the buffer only if it is shorter (otherwise its capacity, set by the user, is kept), and sets it to zero
+	/// </summary>
+	/// <param name="data">The big integer</param>
+	/// <param name="size">The words needed</param>
+	static void PrepareDestination(BigInt_T& data, std::size_t size) {
 
-				// Check the high bits...
+		if (data.Size < size) {
 
-				std::uint8_t digit = (bcdBuffer[i] & HIGH_BITS) >> 4;
-				if (digit > 4) {
+			Clear(data);
+			Resize(data, size);
+		}
 
-					digit -= 3;
-					bcdBuffer[i] = (digit << 4) | (LOW_BITS & bcdBuffer[i]);
-				}
+		memset(data.Buffer, 0, data.Size * sizeof(WORD));
+	}
 
-				// and the low bits
+	/// <summary>
+	/// Reads validated digits into a big integer. Below the divide-and-conquer threshold they are read straight into its buffer, so nothing
+	/// is allocated but the words it lacks
+	/// </summary>
+	/// <param name="data">The big integer</param>
+	/// <param name="digits">The digits</param>
+	/// <param name="length">The number of digits (at least one)</param>
+	/// <param name="sign">The sign</param>
+	/// <param name="base">The base</param>
+	static void ReadNumber(BigInt_T& data, const char* digits, std::size_t length, bool sign, int base) {
 
-				digit = bcdBuffer[i] & LOW_BITS;
-				if (digit > 4) {
+		constexpr std::size_t BITS_PER_WORD = sizeof(WORD) * 8;
 
-					digit -= 3;
-					bcdBuffer[i] = digit | (HIGH_BITS & bcdBuffer[i]);
-				}
+		// The zeros at the start would only take more words
+		while (length > 1 && digits[0] == '0') {
+
+			digits++;
+			length--;
+		}
+
+		const unsigned int bits = GetDigitBits(base);
+		if (bits != 0) {
+
+			PrepareDestination(data, (length * bits + BITS_PER_WORD - 1) / BITS_PER_WORD);
+			ReadBits(data.Buffer, digits, length, bits);
+		}
+
+		else {
+
+			const Radix radix = GetRadix(base);
+			const std::size_t m = (length + radix.ChunkDigits - 1) / radix.ChunkDigits;
+			if (m < FROM_STRING_THRESHOLD) {
+
+				PrepareDestination(data, MaxWords(length, radix));
+				ReadDigitsBasecase(data.Buffer, digits, length, radix);
+			}
+
+			else {
+
+				std::size_t level = 0;
+				while (((std::size_t)2 << level) < m)
+					level++;
+
+				std::vector<const RadixPower*> powers;
+				GetRadixPowers(radix, powers, level + 1, false);
+
+				BigInt_T value;
+				ReadDigits(value, digits, length, radix, powers);
+				PrepareDestination(data, CountSignificantWords(value));
+				Copy(data, value);
 			}
 		}
 
-		if (!capacityAlreadySet)
-			ShrinkToFit(data);
+		// Establish sign
+		data.Sign = IsZero(data) ? BI_PLUS_SIGN : sign;
+	}
+
+	bool FromString(BigInt_T& data, const std::string& str, int base) {
+
+		if (base < 2 || base > 36)
+			throw std::invalid_argument("Invalid base");
+
+		// If the string is empty, return null
+		if (str.empty())
+			return false;
+
+		// Check if the number is positive or negative
+		const bool sign = str[0] == '-';
+		const std::size_t strLength = str.length() - sign;
+		if (strLength == 0)
+			return false;
+
+		// Check the string is made up by digits of the base only
+		const char* digits = str.data() + sign;
+		if (ScanDigits(digits, strLength, base) != strLength)
+			return false;
+
+		ReadNumber(data, digits, strLength, sign, base);
 
 		return true;
 	}
+
+	const char* FromChars(const char* first, const char* last, BigInt_T& data, int base) {
+
+		if (base < 2 || base > 36)
+			throw std::invalid_argument("Invalid base");
+
+		const bool sign = first != last && *first == '-';
+		const char* digits = first + sign;
+		const std::size_t length = ScanDigits(digits, last - digits, base);
+		if (length == 0)
+			return nullptr;
+
+		ReadNumber(data, digits, length, sign, base);
+
+		return digits + length;
+	}
 }
@@ -4,6 +4,8 @@
 
 #include <BigInteger.hpp>
 
+#include "Thresholds.hpp"
+
 #undef bi_memcpy
 #if defined(_WIN32)
 	#define bi_memcpy(dest, dest_size, src, src_size) memcpy_s((char*)(dest), dest_size, src, src_size)
@@ -18,8 +20,25 @@
 	#define bi_memmove(dest, dest_size, src, src_size) std::memmove((char*)(dest), src, src_size)
 #endif
 
-constexpr std::uint8_t HIGH_BITS = 0xF0;
-constexpr std::uint8_t LOW_BITS = 0x0F;
+// The default number-theoretic transform multiplication mode: BI_NTT_AUTO, BI_NTT_ON or BI_NTT_OFF (it can be overridden at compile time)
+#ifndef BI_NTT_MODE
+	#define BI_NTT_MODE BI_NTT_AUTO
+#endif
+
+// The default number of threads used by the multiplication, where 1 means that it is serial (it can be overridden at compile time)
+#ifndef BI_THREAD_COUNT
+	#define BI_THREAD_COUNT 1
+#endif
+
+// The default limb size from which the multiplication is split among the threads (it can be overridden at compile time)
+#ifndef BI_PARALLEL_THRESHOLD
+	#define BI_PARALLEL_THRESHOLD 16384
+#endif
+
+// The default number of divisors whose reciprocal is kept for the next divisions, where 0 disables the cache (it can be overridden at compile time)
+#ifndef BI_RECIPROCAL_CACHE_SIZE
+	#define BI_RECIPROCAL_CACHE_SIZE 4
+#endif
 
 namespace Utils {
 
@@ -191,6 +210,77 @@ namespace Utils {
 	/// <param name="b">The second factor</param>
 	void Mult(BigInt_T& a, const BigInt_T& b);
 
+	/// <summary>
+	/// Squares the big integer. The big integer buffer could be resized if overflow occurs. It is faster than multiplying the big integer by itself
+	/// </summary>
+	/// <param name="data">The big integer to square, where the result will be stored</param>
+	void Square(BigInt_T& data);
+
+	/// <summary>
+	/// Sets the limb size from which the multiplication switches to the Schonhage-Strassen algorithm (both factors must reach it)
+	/// </summary>
+	/// <param name="limbs">The threshold in limbs (values lower than 64 are raised to 64)</param>
+	void SetSSAThreshold(std::size_t limbs);
+
+	/// <returns>The limb size from which the multiplication switches to the Schonhage-Strassen algorithm</returns>
+	std::size_t GetSSAThreshold();
+
+	/// <summary>
+	/// Sets the number-theoretic transform multiplication mode
+	/// </summary>
+	/// <param name="mode">BI_NTT_AUTO to select it by size, BI_NTT_ON to always use it, BI_NTT_OFF to never use it</param>
+	void SetNTTMode(int mode);
+
+	/// <returns>The number-theoretic transform multiplication mode</returns>
+	int GetNTTMode();
+
+	/// <summary>
+	/// Sets the limb size from which the multiplication switches to the number-theoretic transform in automatic mode (both factors must reach it)
+	/// </summary>
+	/// <param name="limbs">The threshold in limbs</param>
+	void SetNTTThreshold(std::size_t limbs);
+
+	/// <returns>The limb size from which the multiplication switches to the number-theoretic transform in automatic mode</returns>
+	std::size_t GetNTTThreshold();
+
+	/// <summary>
+	/// Allows or forbids the BMI2/ADX multiply-accumulate kernel (it is only used where the processor supports it)
+	/// </summary>
+	/// <param name="enabled">True to use the kernel where the processor supports it, false to always use the portable one</param>
+	void SetADXKernel(bool enabled);
+
+	/// <returns>True if the multiplication uses the BMI2/ADX kernel</returns>
+	bool GetADXKernel();
+
+	/// <summary>
+	/// Sets the number of threads used by the multiplication. The top recursion levels of huge products are split among them
+	/// </summary>
+	/// <param name="threads">The number of threads (1 to keep the multiplication serial, 0 to use all the hardware threads)</param>
+	void SetThreadCount(std::size_t threads);
+
+	/// <returns>The number of threads used by the multiplication</returns>
+	std::size_t GetThreadCount();
+
+	/// <summary>
+	/// Sets the limb size from which the multiplication is split among the threads (both factors must reach it)
+	/// </summary>
+	/// <param name="limbs">The threshold in limbs (values lower than 8 are raised to 8)</param>
+	void SetParallelThreshold(std::size_t limbs);
+
+	/// <returns>The limb size from which the multiplication is split among the threads</returns>
+	std::size_t GetParallelThreshold();
+
+	/// <summary>
+	/// Sets the limb size from which the multiplication or the division switches to the given algorithm (both factors, or the divisor and the quotient, must reach it)
+	/// </summary>
+	/// <param name="algorithm">BI_KARATSUBA, BI_TOOM_COOK_3, BI_TOOM_COOK_4, BI_TOOM_COOK_6, BI_TOOM_COOK_8, BI_NTT, BI_SSA, BI_PARALLEL, BI_BURNIKEL_ZIEGLER or BI_NEWTON</param>
+	/// <param name="limbs">The threshold in limbs (values lower than 8 are raised to 8 for the Karatsuba algorithm, values lower than 2 are raised to 2 for the Burnikel-Ziegler algorithm and Newton's method)</param>
+	void SetThreshold(int algorithm, std::size_t limbs);
+
+	/// <param name="algorithm">BI_KARATSUBA, BI_TOOM_COOK_3, BI_TOOM_COOK_4, BI_TOOM_COOK_6, BI_TOOM_COOK_8, BI_NTT, BI_SSA, BI_PARALLEL, BI_BURNIKEL_ZIEGLER or BI_NEWTON</param>
+	/// <returns>The limb size from which the multiplication or the division switches to the given algorithm</returns>
+	std::size_t GetThreshold(int algorithm);
+
 	/// <summary>
 	/// Divides the first big integer by the second one. The result is stored in the first one. The first big integer buffer could be resized if
 	/// overflow occurs
@@ -200,6 +290,149 @@ namespace Utils {
 	/// <param name="remainder">The division remainder (nullptr by default)</param>
 	void Div(BigInt_T& a, const BigInt_T& b, BigInt_T* remainder = nullptr);
 
+	/// <summary>
+	/// Computes the remainder of the division of the first big integer by the second one, without storing the quotient. The result is stored
+	/// in the first one
+	/// </summary>
+	/// <param name="a">The dividend, where the remainder (with the sign of the dividend) will be stored</param>
+	/// <param name="b">The divisor (it cannot be zero)</param>
+	void Mod(BigInt_T& a, const BigInt_T& b);
+
+	/// <summary>
+	/// Rounds a truncated division toward negative or positive infinity, fixing the quotient and the remainder. A zero quotient or remainder
+	/// gets the plus sign
+	/// </summary>
+	/// <param name="quotient">The quotient rounded toward zero (nullptr if not needed)</param>
+	/// <param name="remainder">The remainder with the sign of the dividend</param>
+	/// <param name="divisor">The divisor</param>
+	/// <param name="rounding">BI_ROUND_TRUNC, BI_ROUND_FLOOR or BI_ROUND_CEIL</param>
+	void RoundDivision(BigInt_T* quotient, BigInt_T& remainder, const BigInt_T& divisor, int rounding);
+
+	/// <summary>
+	/// Divides a big integer by a native unsigned integer with a single pass over its words. The result is stored in the big integer
+	/// </summary>
+	/// <param name="data">The dividend, where the quotient (with the sign of the dividend) will be stored</param>
+	/// <param name="divisor">The divisor (it cannot be zero)</param>
+	/// <returns>The remainder's magnitude</returns>
+	std::uint64_t DivWord(BigInt_T& data, std::uint64_t divisor);
+
+	/// <summary>
+	/// Computes the remainder of the division of a big integer by a native unsigned integer, without storing the quotient
+	/// </summary>
+	/// <param name="data">The dividend</param>
+	/// <param name="divisor">The divisor (it cannot be zero)</param>
+	/// <param name="remainder">The remainder with the sign of the dividend (nullptr by default, it can be the dividend itself)</param>
+	/// <returns>The remainder's magnitude</returns>
+	std::uint64_t ModWord(const BigInt_T& data, std::uint64_t divisor, BigInt_T* remainder = nullptr);
+
+	/// <summary>
+	/// Prepares a divisor for repeated divisions, normalizing it and computing its reciprocals
+	/// </summary>
+	/// <param name="divisor">The prepared divisor</param>
+	/// <param name="value">The divisor value (it cannot be zero)</param>
+	void PrepareDivisor(Divisor_T& divisor, const BigInt_T& value);
+
+	/// <summary>
+	/// Divides a big integer by a prepared divisor. The result is stored in the big integer
+	/// </summary>
+	/// <param name="a">The dividend, where the result will be stored</param>
+	/// <param name="b">The prepared divisor (see PrepareDivisor)</param>
+	/// <param name="remainder">The division remainder (nullptr by default)</param>
+	void Div(BigInt_T& a, const Divisor_T& b, BigInt_T* remainder = nullptr);
+
+	/// <summary>
+	/// Divides two big integers when the division is known to be exact. The result is stored in the first big integer
+	/// </summary>
+	/// <param name="a">The dividend (a multiple of the divisor), where the quotient will be stored</param>
+	/// <param name="b">The divisor (it cannot be zero)</param>
+	void DivExact(BigInt_T& a, const BigInt_T& b);
+
+	/// <summary>
+	/// Prepares a Montgomery context for an odd modulus
+	/// </summary>
+	/// <param name="context">The Montgomery context</param>
+	/// <param name="modulus">The modulus (it must be odd, its sign is ignored)</param>
+	void PrepareMontgomery(Montgomery_T& context, const BigInt_T& modulus);
+
+	/// <summary>
+	/// Converts a big integer into the Montgomery form (aR mod m)
+	/// </summary>
+	/// <param name="data">The big integer, where the result will be stored</param>
+	/// <param name="context">The Montgomery context</param>
+	void ToMontgomery(BigInt_T& data, const Montgomery_T& context);
+
+	/// <summary>
+	/// Converts a big integer out of the Montgomery form (aR^-1 mod m)
+	/// </summary>
+	/// <param name="data">The big integer, where the result will be stored</param>
+	/// <param name="context">The Montgomery context</param>
+	void FromMontgomery(BigInt_T& data, const Montgomery_T& context);
+
+	/// <summary>
+	/// Multiplies two big integers in the Montgomery form (abR^-1 mod m). The result is stored in the first one
+	/// </summary>
+	/// <param name="first">The first factor, where the result will be stored</param>
+	/// <param name="second">The second factor</param>
+	/// <param name="context">The Montgomery context</param>
+	void MontgomeryMult(BigInt_T& first, const BigInt_T& second, const Montgomery_T& context);
+
+	/// <summary>
+	/// Squares a big integer in the Montgomery form (a^2R^-1 mod m)
+	/// </summary>
+	/// <param name="data">The big integer, where the result will be stored</param>
+	/// <param name="context">The Montgomery context</param>
+	void MontgomerySquare(BigInt_T& data, const Montgomery_T& context);
+
+	/// <summary>
+	/// Computes a modular power in the Montgomery form with the sliding window method
+	/// </summary>
+	/// <param name="base">The base (not in the Montgomery form), where the result will be stored</param>
+	/// <param name="exponent">The exponent (it cannot be negative)</param>
+	/// <param name="context">The Montgomery context</param>
+	void MontgomeryPow(BigInt_T& base, const BigInt_T& exponent, const Montgomery_T& context);
+
+	/// <summary>
+	/// Computes a modular power with the sliding window method, in the Montgomery form if the modulus is odd
+	/// </summary>
+	/// <param name="base">The base, where the result will be stored</param>
+	/// <param name="exponent">The exponent (it cannot be negative)</param>
+	/// <param name="modulus">The modulus (it cannot be zero, its sign is ignored)</param>
+	void PowMod(BigInt_T& base, const BigInt_T& exponent, const BigInt_T& modulus);
+
+	/// <summary>
+	/// Precomputes the comb table of a fixed-base modular exponentiation
+	/// </summary>
+	/// <param name="data">The fixed-base table</param>
+	/// <param name="base">The base</param>
+	/// <param name="modulus">The modulus (it must be odd, its sign is ignored)</param>
+	/// <param name="exponent_bits">The longest exponent in bits that the table covers (0 for the modulus bits)</param>
+	/// <param name="teeth">The comb teeth, at most 16 (0 to choose them from the exponent bits)</param>
+	void PrepareFixedBase(FixedBase_T& data, const BigInt_T& base, const BigInt_T& modulus, std::size_t exponent_bits, std::size_t teeth);
+
+	/// <summary>
+	/// Computes a modular power of a fixed base with its comb table
+	/// </summary>
+	/// <param name="exponent">The exponent (it cannot be negative), where the result will be stored</param>
+	/// <param name="data">The fixed-base table (see PrepareFixedBase)</param>
+	void FixedBasePow(BigInt_T& exponent, const FixedBase_T& data);
+
+	/// <summary>
+	/// Computes the reciprocal of a big integer as a fixed-point number, that is 2^precision_bits / data rounded toward zero, with Newton's
+	/// method. The last reciprocals are cached, so they are not computed again for the same divisor
+	/// </summary>
+	/// <param name="data">The number to invert, where the result will be stored</param>
+	/// <param name="precision_bits">The fixed-point precision in bits</param>
+	void Reciprocal(BigInt_T& data, std::size_t precision_bits);
+
+	/// <summary>
+	/// Sets how many divisors keep their reciprocal for the next divisions and calls to Reciprocal
+	/// </summary>
+	/// <param name="entries">The number of cached reciprocals (0 to disable the cache and free its memory)</param>
+	void SetReciprocalCacheSize(std::size_t entries);
+
+	/// <returns>The number of cached reciprocals</returns>
+	std::size_t GetReciprocalCacheSize();
+
 	// --- Bitwise functions ---
 
 	/// <summary>
@@ -252,14 +485,45 @@ namespace Utils {
 	/// Converts a big integer to a printable string
 	/// </summary>
 	/// <param name="data">The desired big integer</param>
-	/// <returns>A readable version of the number expressed in base 10 and saved as a string</returns>
-	std::string ToString(const BigInt_T& data);
+	/// <param name="base">The base, from 2 to 36 (the digits above 9 are lowercase letters)</param>
+	/// <returns>A readable version of the number expressed in the given base and saved as a string</returns>
+	std::string ToString(const BigInt_T& data, int base = 10);
+
+	/// <summary>
+	/// Counts the digits of a big integer in a base
+	/// </summary>
+	/// <param name="data">The big integer</param>
+	/// <param name="base">The base, from 2 to 36</param>
+	/// <returns>The exact number of digits, without the minus sign</returns>
+	std::size_t CountDigits(const BigInt_T& data, int base);
+
+	/// <summary>
+	/// Writes a big integer in a base into a character range, without allocating below the divide-and-conquer threshold
+	/// </summary>
+	/// <param name="first">The start of the range</param>
+	/// <param name="last">The end of the range</param>
+	/// <param name="data">The big integer</param>
+	/// <param name="base">The base, from 2 to 36 (the digits above 9 are lowercase letters)</param>
+	/// <returns>The end of the written characters, or nullptr if the range is too short</returns>
+	char* ToChars(char* first, char* last, const BigInt_T& data, int base);
 
 	/// <summary>
 	/// Converts a string to a big integer
 	/// </summary>
 	/// <param name="data">The big integer variable to store the converted number</param>
 	/// <param name="str">The string to convert</param>
+	/// <param name="base">The base, from 2 to 36 (the digits above 9 are letters in any case)</param>
 	/// <returns>True if the convertion has succeeded, false if not</returns>
-	bool FromString(BigInt_T& data, const std::string& str);
+	bool FromString(BigInt_T& data, const std::string& str, int base = 10);
+
+	/// <summary>
+	/// Reads the longest number at the start of a character range (an optional minus sign followed by digits), without allocating below the
+	/// divide-and-conquer threshold but for the words that the big integer lacks
+	/// </summary>
+	/// <param name="first">The start of the range</param>
+	/// <param name="last">The end of the range</param>
+	/// <param name="data">The big integer variable to store the converted number (unchanged if there is no number)</param>
+	/// <param name="base">The base, from 2 to 36 (the digits above 9 are letters in any case)</param>
+	/// <returns>The end of the number, or nullptr if the range does not start with one</returns>
+	const char* FromChars(const char* first, const char* last, BigInt_T& data, int base);
 }